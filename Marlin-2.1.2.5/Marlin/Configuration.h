@@ -744,6 +744,10 @@
   #define MPC_SMOOTHING_FACTOR 0.5f                   // (0.0...1.0) Noisy temperature sensors may need a lower value for stabilization.
   #define MPC_MIN_AMBIENT_CHANGE 1.0f                 // (K/s) Modeled ambient temperature rate of change, when correcting model inaccuracies.
   #define MPC_STEADYSTATE 0.5f                        // (K/s) Temperature change rate for steady state logic to be enforced.
+  //#define MPC_FLOW_LOOKAHEAD                        // Plan heater power for the extrusion rate queued ahead, to ramp up before fast moves.
+  #if ENABLED(MPC_FLOW_LOOKAHEAD)
+    #define MPC_FLOW_LOOKAHEAD_TIME 1.0f              // (s) How far ahead to look. About the lag from heater to melt zone.
+  #endif
 
   #define MPC_TUNING_POS { X_CENTER, Y_CENTER, 1.0f } // (mm) M306 Autotuning position, ideally bed center at first layer height.
   #define MPC_TUNING_END_Z 10.0f                      // (mm) M306 Autotuning final Z position.
@@ -1984,6 +1988,14 @@
   #define SEGMENT_LEVELED_MOVES
   #define LEVELED_SEGMENT_LENGTH 5.0 // (mm) Length of all segments (except the last one)
 
+  /**
+   * Precompute the bilinear coefficients of every mesh cell, so each leveled
+   * point costs a cell lookup and three multiplies. Helps Delta, SCARA and
+   * SEGMENT_LEVELED_MOVES, which level every segment. ABL Bilinear and UBL only.
+   * Uses 16 bytes of RAM per mesh cell.
+   */
+  //#define MESH_CELL_CACHE
+
   /**
    * Enable the G26 Mesh Validation Pattern tool.
    */
@@ -2036,7 +2048,7 @@
   //#define MESH_EDIT_GFX_OVERLAY   // Display a graphics overlay while editing the mesh
 
   #define MESH_INSET 1              // Set Mesh bounds as an inset region of the bed
-  #define GRID_MAX_POINTS_X 10      // Don't use more than 15 points per axis, implementation limited.
+  #define GRID_MAX_POINTS_X 10      // Don't use more than 31 points per axis, implementation limited.
   #define GRID_MAX_POINTS_Y GRID_MAX_POINTS_X
 
   //#define UBL_HILBERT_CURVE       // Use Hilbert distribution for less travel when probing multiple points
@@ -68,6 +68,37 @@
  */
 #define THERMOCOUPLE_MAX_ERRORS 15
 
+/**
+ * Direct Thermistor Lookup
+ * Find the thermistor table segment for an ADC reading from an index on its top
+ * bits instead of a binary search, and interpolate with a precomputed fixed-point
+ * slope instead of a float division. Results match the table lookup. The index is
+ * built at compile time and adds about 400 bytes of flash per table in use.
+ * Custom thermistors (1000) still use the Steinhart-Hart equation.
+ * With MARLIN_DEV_MODE, D8 benchmarks both lookups.
+ */
+//#define THERMISTOR_DIRECT_LOOKUP
+
+/**
+ * Temperature Sensor Filters
+ * Filter each oversampled ADC reading before it is converted to a temperature.
+ * Each class of sensor has its own chain: { median, outlier, EMA shift, divider }
+ *   median  : Take the median of the last 3 readings to reject single spikes.
+ *   outlier : Hold back readings that jump more than this (in 10-bit ADC counts)
+ *             for up to 3 readings in a row. 0 = off.
+ *   EMA     : Moving average giving each reading a weight of 1/2^N. 0 = off.
+ *   divider : Sample the sensor on only 1 of N rounds of ADC readings (1, 2, 4, 8, 16).
+ *             Skipped sensors make the other rounds shorter, so hotends are sampled
+ *             more often. Each reading then averages fewer samples.
+ * Filtering delays the response to real changes, including MINTEMP/MAXTEMP.
+ */
+//#define TEMP_SENSOR_FILTERS
+#if ENABLED(TEMP_SENSOR_FILTERS)
+  #define TEMP_FILTER_HOTEND { true, 16, 1, 1 }
+  #define TEMP_FILTER_BED    { true, 16, 2, 4 }
+  #define TEMP_FILTER_OTHER  { true, 16, 2, 8 } // Chamber, Cooler, Probe, Board
+#endif
+
 //
 // Custom Thermistor 1000 parameters
 //
@@ -1063,7 +1094,13 @@
 /**
  * Input Shaping -- EXPERIMENTAL
  *
- * Zero Vibration (ZV) Input Shaping for X and/or Y movements.
+ * Input Shaping for X and/or Y movements, using one of these shapers:
+ *   ZV       : Zero Vibration. Two impulses, the shortest delay (1/2 period).
+ *   MZV      : Modified ZV. Three impulses spread over 3/4 period.
+ *   EI       : Extra Insensitive. Three impulses spread over one period.
+ *              More tolerant of frequency error than ZV or MZV.
+ *   2HUMP_EI : Two-hump EI. Four impulses spread over 1-1/2 periods.
+ *              Most tolerant of frequency error, with the most smoothing.
  *
  * This option uses a lot of SRAM for the step buffer. The buffer size is
  * calculated automatically from SHAPING_FREQ_[XY], DEFAULT_AXIS_STEPS_PER_UNIT,
@@ -1077,7 +1114,7 @@
  *
  *  D<factor>    Set the zeta/damping factor. If axes (X, Y, etc.) are not specified, set for all axes.
  *  F<frequency> Set the frequency. If axes (X, Y, etc.) are not specified, set for all axes.
- *  T[map]       Input Shaping type, 0:ZV, 1:EI, 2:2H EI (not implemented yet)
+ *  T<type>      Set the shaper type. 0:ZV, 1:EI, 2:2HUMP_EI, 3:MZV
  *  X<1>         Set the given parameters only for the X axis.
  *  Y<1>         Set the given parameters only for the Y axis.
  */
@@ -1087,14 +1124,39 @@
   #if ENABLED(INPUT_SHAPING_X)
     #define SHAPING_FREQ_X  40.0        // (Hz) The default dominant resonant frequency on the X axis.
     #define SHAPING_ZETA_X   0.15       // Damping ratio of the X axis (range: 0.0 = no damping to 1.0 = critical damping).
+    #define SHAPING_TYPE_X   0          // Shaper type on the X axis. 0:ZV, 1:EI, 2:2HUMP_EI, 3:MZV
   #endif
   #if ENABLED(INPUT_SHAPING_Y)
     #define SHAPING_FREQ_Y  40.0        // (Hz) The default dominant resonant frequency on the Y axis.
     #define SHAPING_ZETA_Y   0.15       // Damping ratio of the Y axis (range: 0.0 = no damping to 1.0 = critical damping).
+    #define SHAPING_TYPE_Y   0          // Shaper type on the Y axis. 0:ZV, 1:EI, 2:2HUMP_EI, 3:MZV
   #endif
   //#define SHAPING_MIN_FREQ  20.0      // (Hz) By default the minimum of the shaping frequencies. Override to affect SRAM usage.
   //#define SHAPING_MAX_STEPRATE 10000  // By default the maximum total step rate of the shaped axes. Override to affect SRAM usage.
+  //#define SHAPING_MAX_IMPULSES 4      // (2-4) Most impulses of any shaper M593 can select. 2:ZV, 3:+MZV/EI, 4:+2HUMP_EI.
+                                        // By default 2 on AVR and 4 otherwise. Fewer impulses use less SRAM.
   //#define SHAPING_MENU                // Add a menu to the LCD to set shaping parameters.
+
+  /**
+   * Resonance Test
+   *
+   * Add M958 to shake an axis through a range of frequencies, measure the
+   * response with an ADXL345 accelerometer on the toolhead, and suggest
+   * M593 frequency, damping and shaper type. Use M958 R to apply them.
+   * The native target replays samples from RESONANCE_ACCEL_FILE instead.
+   */
+  //#define RESONANCE_TEST
+  #if ENABLED(RESONANCE_TEST)
+    #define RESONANCE_MIN_FREQ       10   // (Hz) Default lowest test frequency. Set with M958 L.
+    #define RESONANCE_MAX_FREQ      100   // (Hz) Default highest test frequency. Set with M958 H.
+    #define RESONANCE_FREQ_STEP       1   // (Hz) Default frequency step. Set with M958 S.
+    #define RESONANCE_ACCEL_PER_HZ   75   // (mm/s²/Hz) Default shaking acceleration per Hz. Set with M958 A.
+    #define RESONANCE_SHAKE_TIME    500   // (ms) Default shaking time at each frequency. Set with M958 P.
+    #define RESONANCE_MAX_BINS      128   // Most frequencies in one test. Each uses 4 bytes of SRAM.
+    #define RESONANCE_SAMPLE_RATE  3200   // (Hz) Accelerometer sample rate: 3200, 1600, 800 or 400
+    //#define ADXL345_CS_PIN         -1   // ADXL345 chip select. The ADXL345 shares the hardware SPI bus.
+    #define RESONANCE_ACCEL_FILE "resonance.txt" // (Native only) "x y z" samples in mm/s², with a '#' line before each frequency
+  #endif
 #endif
 
 // @section motion
@@ -1276,6 +1338,17 @@
  */
 //#define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Acceleration Ramp Table
+ * Replace the per-ISR speed calculation of trapezoid blocks with a walk along a
+ * precomputed step interval ramp. The planner scales the ramp for each block's
+ * acceleration and finds where its entry speed lies, so the Stepper ISR only
+ * advances a position and interpolates the next interval. Intended for 8-bit
+ * boards, where it frees ISR cycles for higher step rates.
+ * Not compatible with S_CURVE_ACCELERATION, LIN_ADVANCE or ADAPTIVE_STEP_SMOOTHING.
+ */
+//#define ACCEL_RAMP_TABLE
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -1537,6 +1610,25 @@
   //#define SD_IGNORE_AT_STARTUP            // Don't mount the SD card when starting up
   //#define SDCARD_READONLY                 // Read-only SD card (to save over 2K of flash)
 
+  /**
+   * Read the file being printed in whole blocks into a two-part buffer instead
+   * of a byte at a time through the shared block cache. A free half is refilled
+   * with a multi-block read, preferably while the command queue is full.
+   * Uses 1K of SRAM per block. With 1 block each refill is a single-block read.
+   */
+  //#define SD_READ_AHEAD
+  #if ENABLED(SD_READ_AHEAD)
+    #define SD_READ_AHEAD_BLOCKS 2          // Blocks (512 bytes) in each half of the buffer
+  #endif
+
+  /**
+   * Print files converted ahead of time by buildroot/share/scripts/gcode_preparse.py
+   * Lines become binary records holding the parsed command and fixed-point values,
+   * so printing skips the G-code parser and strtof. Files are about half the size.
+   * Requires FASTER_GCODE_PARSER.
+   */
+  //#define SD_PREPARSED_GCODE
+
   //#define GCODE_REPEAT_MARKERS            // Enable G-code M808 to set repeat markers and do looping
 
   #define SD_PROCEDURE_DEPTH 1              // Increase if you need more nested M32 calls
@@ -2190,6 +2282,20 @@
 
 #if BOTH(AUTO_BED_LEVELING_UBL, EEPROM_SETTINGS)
   //#define OPTIMIZED_MESH_STORAGE  // Store mesh with less precision to save EEPROM space
+  #if ENABLED(OPTIMIZED_MESH_STORAGE)
+    /**
+     * Store each mesh as its difference from a local plane, about one byte per point
+     * for a smooth mesh. Saving fails if the mesh doesn't fit in the slot.
+     */
+    //#define COMPRESSED_MESH_STORAGE
+    #if ENABLED(COMPRESSED_MESH_STORAGE)
+      #define COMPRESSED_MESH_SLOT_SIZE ((GRID_MAX_POINTS) * 5 / 4 + 2) // (bytes) Space reserved for each mesh
+    #endif
+  #endif
+  //#define MESH_STORE_SDCARD       // Store meshes on the SD card (as MESH00.UBL...) instead of EEPROM
+  #if ENABLED(MESH_STORE_SDCARD)
+    #define MESH_STORE_SD_SLOTS 10  // Number of mesh slots on the card
+  #endif
 #endif
 
 /**
@@ -2294,6 +2400,10 @@
   #define MAX_ARC_SEGMENT_MM      1.0 // (mm) Maximum length of each arc segment
   #define MIN_CIRCLE_SEGMENTS    72   // Minimum number of segments in a complete circle
   //#define ARC_SEGMENTS_PER_SEC 50   // Use the feedrate to choose the segment length
+  //#define ARC_CHORD_TOLERANCE 0.01 // (mm) Size segments by chord error instead of MAX_ARC_SEGMENT_MM, using a fixed-point rotation
+  #ifdef ARC_CHORD_TOLERANCE
+    #define ARC_CHORD_MAX_SEGMENT_MM 10.0 // (mm) Maximum length of each arc segment sized by chord error
+  #endif
   #define N_ARC_CORRECTION       25   // Number of interpolated segments between corrections
   //#define ARC_P_CIRCLES             // Enable the 'P' parameter to specify complete circles
   //#define SF_ARC_FIX                // Enable only if using SkeinForge with "Arc Point" fillet procedure
@@ -2334,6 +2444,25 @@
 // Moves (or segments) with fewer steps than this will be joined with the next move
 #define MIN_STEPS_PER_SEGMENT 6
 
+/**
+ * Merge Collinear Moves
+ *
+ * Join runs of short, nearly straight G0/G1 moves into a single planner block so
+ * high-polygon models don't exhaust the buffer and limit the look-ahead speed.
+ * A move is held until the next one arrives and is extended while no replaced
+ * vertex strays more than MERGE_MOVES_TOLERANCE from the joined line and E per mm
+ * stays within MERGE_MOVES_E_RATIO. Moves are only held while more commands are
+ * waiting, and moves segmented for bed leveling are not merged. Commands that
+ * don't queue a move (e.g., M106) may take effect one held move early.
+ */
+//#define MERGE_COLLINEAR_MOVES
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #define MERGE_MOVES_TOLERANCE  0.005  // (mm) Maximum distance of a replaced vertex from the joined line
+  #define MERGE_MOVES_E_RATIO    0.05   // Maximum relative difference in E per mm between joined moves
+  #define MERGE_MOVES_MAX_LENGTH 1.0    // (mm) Only moves shorter than this are joined
+  #define MERGE_MOVES_MAX_COUNT  8      // Maximum number of moves joined into one block
+#endif
+
 /**
  * Minimum delay before and after setting the stepper DIR (in ns)
  *     0 : No delay (Expect at least 10µS since one Stepper ISR must transpire)
@@ -2377,6 +2506,26 @@
  */
 //#define MAXIMUM_STEPPER_RATE 250000
 
+/**
+ * Stepper ISR Profiler
+ * Count the CPU cycles taken by each phase of the stepper ISR and report
+ * histograms with M881. The maximum step rates come from the estimates in
+ * stepper.h (ISR_BASE_CYCLES, etc.), so use this to check them on your board.
+ * Adds a little time to every stepper ISR and uses ~800 bytes of SRAM.
+ */
+//#define STEPPER_ISR_PROFILE
+#if ENABLED(STEPPER_ISR_PROFILE)
+  /**
+   * Set the step rates where multi-stepping starts from the measured ISR
+   * times instead of the estimates. Make some fast moves, then use M881 C
+   * to calibrate and M500 to save.
+   */
+  //#define CALIBRATE_MULTISTEPPING
+  #if ENABLED(CALIBRATE_MULTISTEPPING)
+    #define MULTISTEPPING_MARGIN 25 // (%) Headroom over the measured ISR time
+  #endif
+#endif
+
 // @section temperature
 
 // Control heater 0 and heater 1 in parallel.
@@ -2390,6 +2539,7 @@
 
 // The number of linear moves that can be in the planner at once.
 // The value of BLOCK_BUFFER_SIZE must be a power of 2 (e.g., 8, 16, 32)
+// 32-bit boards may use up to 1024 for a longer lookahead on dense short segments.
 #if BOTH(SDSUPPORT, DIRECT_STEPPING)
   #define BLOCK_BUFFER_SIZE  8
 #elif ENABLED(SDSUPPORT)
@@ -2398,6 +2548,16 @@
   #define BLOCK_BUFFER_SIZE 16
 #endif
 
+// Stop the planner's reverse pass at the first block whose entry speed is unchanged and
+// skip trapezoid updates that would produce the same step rates. Lowers the per-block
+// planning cost with large buffers and many short segments.
+//#define PLANNER_INCREMENTAL_RECALC
+
+// Keep the block fields used by the look-ahead passes in a dense array beside the block
+// buffer instead of inside each block, so planning touches less memory. Helps on CPUs
+// with a data cache (e.g., Cortex-M7, native) and with large buffers.
+//#define PLANNER_SPLIT_BLOCK
+
 // @section serial
 
 // The ASCII buffer for serial input
@@ -2441,6 +2601,12 @@
 // Not supported on all platforms.
 //#define RX_BUFFER_MONITOR
 
+// Read serial input in blocks of this many bytes and copy runs of plain characters
+// into the command line at once, instead of handling every character separately.
+// Helps the main loop keep up with hosts streaming at high baud rates.
+// Uses this many bytes of SRAM per serial port. Best for 32-bit boards.
+//#define SERIAL_BLOCK_READ 64
+
 /**
  * Emergency Command Parser
  *
@@ -2482,6 +2648,21 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+/**
+ * Windowed acknowledgement. After "M110 W1" the host may have several numbered
+ * lines in flight (BUFSIZE, reported as "Window:") instead of waiting for each "ok".
+ * Executed lines are acknowledged in ranges, e.g., "ok N120-N135".
+ * A lost or corrupt line gets "Resend: N120" (no "ok") and lines already in
+ * flight after it are dropped without errors until N120 comes again, so the host
+ * must go back and send everything from N120 on.
+ * Requires host support. Make RX_BUFFER_SIZE big enough to hold the window.
+ */
+//#define SERIAL_WINDOWED_OK
+#if ENABLED(SERIAL_WINDOWED_OK)
+  #define WINDOWED_OK_DELAY        20 // (ms) Longest time to hold back an acknowledgement
+  #define WINDOWED_RESEND_TIMEOUT 500 // (ms) Ask again if no line comes this long after a "Resend"
+#endif
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
@@ -3687,6 +3868,14 @@
 
 #if ENABLED(FASTER_GCODE_PARSER)
   //#define GCODE_QUOTED_STRINGS  // Support for quoted string parameters
+
+  /**
+   * Parse simple commands once as they are queued, storing the numbers after
+   * the command text in the same buffer. Commands then run without re-scanning
+   * the text or calling strtof, and M808 is handled without a second parse.
+   * Uses 1 byte of SRAM per BUFSIZE. Longer commands are parsed as usual.
+   */
+  //#define GCODE_PARSE_ON_ENQUEUE
 #endif
 
 /**
@@ -4241,6 +4430,16 @@
 
 // Enable Tests that will run at startup and produce a report
 //#define MARLIN_TEST_BUILD
+#if ENABLED(MARLIN_TEST_BUILD)
+  //#define PLANNER_BENCHMARK                      // Report planner blocks/s, latency percentiles and starvation for synthetic moves
+  #if ENABLED(PLANNER_BENCHMARK)
+    //#define PLANNER_BENCHMARK_FILE "bench.gcode" // (Native only) Also replay the G0/G1 moves of this sliced file
+  #endif
+#endif
+
+// (Native only) Run the simulator on a discrete-event clock. Timers fire in turn instead of
+// sleeping, so runs go faster than real time and give the same results every time.
+//#define VIRTUAL_TIME
 
 // Enable Marlin dev mode which adds some special commands
 //#define MARLIN_DEV_MODE
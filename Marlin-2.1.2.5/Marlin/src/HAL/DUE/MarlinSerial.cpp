@@ -315,14 +315,22 @@ int MarlinSerial<Cfg>::peek() {
 
 template<typename Cfg>
 int MarlinSerial<Cfg>::read() {
+  uint8_t v;
+  return readBuffer(&v, 1) ? v : -1;
+}
+
+template<typename Cfg>
+int MarlinSerial<Cfg>::readBuffer(uint8_t * const buf, const int len) {
 
   const ring_buffer_pos_t h = rx_buffer.head;
   ring_buffer_pos_t t = rx_buffer.tail;
 
-  if (h == t) return -1;
-
-  int v = rx_buffer.buffer[t];
-  t = (ring_buffer_pos_t)(t + 1) & (Cfg::RX_SIZE - 1);
+  int n = 0;
+  for (; n < len && t != h; ++n) {
+    buf[n] = rx_buffer.buffer[t];
+    t = (ring_buffer_pos_t)(t + 1) & (Cfg::RX_SIZE - 1);
+  }
+  if (!n) return 0;
 
   // Advance tail
   rx_buffer.tail = t;
@@ -350,7 +358,7 @@ int MarlinSerial<Cfg>::read() {
     }
   }
 
-  return v;
+  return n;
 }
 
 template<typename Cfg>
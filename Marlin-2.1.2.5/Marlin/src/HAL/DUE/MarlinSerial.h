@@ -110,6 +110,7 @@ public:
   static void end();
   static int peek();
   static int read();
+  static int readBuffer(uint8_t * const buf, const int len);
   static void flush();
   static ring_buffer_pos_t available();
   static size_t write(const uint8_t c);
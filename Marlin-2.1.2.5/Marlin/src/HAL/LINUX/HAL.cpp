@@ -56,6 +56,16 @@ uint16_t MarlinHAL::adc_value() {
   return uint16_t((Gpio::get(pin) >> 2) & 0x3FF); // return 10bit value as Marlin expects
 }
 
+#if ENABLED(VIRTUAL_TIME)
+  extern void virtual_time_yield();
+#endif
+
+void MarlinHAL::idletask() {
+  #if ENABLED(VIRTUAL_TIME)
+    virtual_time_yield(); // Waiting in idle() is where virtual time moves forward
+  #endif
+}
+
 void MarlinHAL::reboot() { /* Reset the application state and GPIO */ }
 
 #endif // __PLAT_LINUX__
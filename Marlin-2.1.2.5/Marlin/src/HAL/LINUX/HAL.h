@@ -122,7 +122,7 @@ public:
   static void delay_ms(const int ms) { _delay_ms(ms); }
 
   // Tasks, called from idle()
-  static void idletask() {}
+  static void idletask();
 
   // Reset
   static constexpr uint8_t reset_reason = RST_POWER_ON;
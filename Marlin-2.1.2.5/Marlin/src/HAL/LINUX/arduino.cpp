@@ -34,6 +34,7 @@ void sei() { } // Enable
 void _delay_ms(const int ms) { delay(ms); }
 
 uint32_t millis() {
+  if (Clock::isVirtualTime()) HAL_timer_poll();
   return (uint32_t)Clock::millis();
 }
 
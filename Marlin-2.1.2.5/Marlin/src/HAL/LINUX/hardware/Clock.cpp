@@ -27,5 +27,8 @@
 std::chrono::nanoseconds Clock::startup = std::chrono::high_resolution_clock::now().time_since_epoch();
 uint32_t Clock::frequency = F_CPU;
 double Clock::time_multiplier = 1.0;
+bool Clock::virtual_time = false;
+uint64_t Clock::virtual_nanos = 0;
+Clock::sleep_fn* Clock::sleep_handler = nullptr;
 
 #endif // __PLAT_LINUX__
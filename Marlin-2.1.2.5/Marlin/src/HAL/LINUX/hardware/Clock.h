@@ -45,6 +45,7 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
+    if (Clock::virtual_time) return Clock::virtual_nanos;
     auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
     return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
   }
@@ -62,18 +63,22 @@ public:
   }
 
   static void delayCycles(uint64_t cycles) {
+    if (Clock::virtual_time) return Clock::sleepVirtual((1000000000L / frequency) * cycles);
     std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
   }
 
   static void delayMicros(uint64_t micros) {
+    if (Clock::virtual_time) return Clock::sleepVirtual(micros * 1000);
     std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
   }
 
   static void delayMillis(uint64_t millis) {
+    if (Clock::virtual_time) return Clock::sleepVirtual(millis * 1000000);
     std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
   }
 
   static void delaySeconds(double secs) {
+    if (Clock::virtual_time) return Clock::sleepVirtual(secs * 1000000000.0);
     std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
   }
 
@@ -82,8 +87,42 @@ public:
     Clock::time_multiplier = tm;
   }
 
+  /**
+   * Virtual time: the clock stands still until it is advanced explicitly.
+   * Delays hand the wait to the sleep handler (the timer scheduler) so any
+   * interrupts that fall due in the meantime still run in order.
+   */
+  typedef void (sleep_fn)(uint64_t until_ns);
+
+  static void setVirtualTime(bool vt) {
+    Clock::virtual_nanos = Clock::nanos();
+    Clock::virtual_time = vt;
+  }
+
+  static bool isVirtualTime() {
+    return Clock::virtual_time;
+  }
+
+  static void setSleepHandler(sleep_fn* fn) {
+    Clock::sleep_handler = fn;
+  }
+
+  // Move the virtual clock forward, never backward
+  static void advanceTo(uint64_t ns) {
+    if (ns > Clock::virtual_nanos) Clock::virtual_nanos = ns;
+  }
+
+  static void sleepVirtual(uint64_t ns) {
+    const uint64_t until = Clock::virtual_nanos + ns;
+    if (Clock::sleep_handler) Clock::sleep_handler(until);
+    Clock::advanceTo(until);
+  }
+
 private:
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
+  static bool virtual_time;
+  static uint64_t virtual_nanos;
+  static sleep_fn* sleep_handler;
 };
@@ -0,0 +1,119 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <signal.h>
+#include <stdint.h>
+#include "Clock.h"
+
+/**
+ * Lock-free ring for exactly one producer thread and one consumer thread.
+ * The producer publishes with a release store, the consumer picks up with
+ * an acquire load, so no lock is ever taken. push() is not reentrant, so it
+ * must not be called from a signal handler that may interrupt a push() on the
+ * same ring. ThreadEventRings takes care of that for the timer signals.
+ * S size of the buffer (must be power of 2)
+ */
+template <typename T, uint32_t S>
+class EventRing {
+public:
+  bool push(const T &value) {
+    const uint32_t w = index_write.load(std::memory_order_relaxed);
+    if (w - index_read.load(std::memory_order_acquire) == S) return false;
+    buffer[w & (S - 1)] = value;
+    index_write.store(w + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &value) {
+    const uint32_t r = index_read.load(std::memory_order_relaxed);
+    if (r == index_write.load(std::memory_order_acquire)) return false;
+    value = buffer[r & (S - 1)];
+    index_read.store(r + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static_assert(S && !(S & (S - 1)), "EventRing size must be a power of 2.");
+  std::atomic<uint32_t> index_write{0}, index_read{0};
+  T buffer[S];
+};
+
+/**
+ * One EventRing per producing thread, so the threads generating events
+ * never contend with each other. A thread claims its ring
+ * on first use with a single atomic increment. A full ring drops the event
+ * and counts it rather than blocking the producer.
+ *
+ * The ring slot is cached per thread and per type, so only one instance of
+ * each ThreadEventRings type should exist.
+ *
+ * In real time the timers fire as SIGRTMIN on whichever thread is running,
+ * so a handler could interrupt a push() to the same ring. The signal is held
+ * off for the length of the push. Virtual time fires timers from the main
+ * loop and needs no masking.
+ */
+template <typename T, uint32_t S, uint8_t THREADS=4>
+class ThreadEventRings {
+public:
+  bool push(const T &value) {
+    sigset_t timer_mask, saved_mask;
+    const bool mask = !Clock::isVirtualTime();
+    if (mask) {
+      sigemptyset(&timer_mask);
+      sigaddset(&timer_mask, SIGRTMIN);
+      pthread_sigmask(SIG_BLOCK, &timer_mask, &saved_mask);
+    }
+    EventRing<T, S> * const ring = local();
+    const bool pushed = ring && ring->push(value);
+    if (mask) pthread_sigmask(SIG_SETMASK, &saved_mask, nullptr);
+    if (!pushed) dropped.fetch_add(1, std::memory_order_relaxed);
+    return pushed;
+  }
+
+  // Consumer: pop everything currently queued, ring by ring
+  template <typename F>
+  void drain(F fn) {
+    const uint8_t count = claimed.load(std::memory_order_acquire);
+    T value;
+    for (uint8_t i = 0; i < count && i < THREADS; ++i)
+      while (rings[i].pop(value)) fn(value);
+  }
+
+  uint32_t getDropped() { return dropped.load(std::memory_order_relaxed); }
+
+private:
+  EventRing<T, S>* local() {
+    static thread_local uint8_t slot = 0xFF;
+    if (slot == 0xFF) {
+      const uint8_t s = claimed.fetch_add(1, std::memory_order_acq_rel);
+      slot = s < THREADS ? s : THREADS;
+    }
+    return slot < THREADS ? &rings[slot] : nullptr;
+  }
+
+  std::unique_ptr<EventRing<T, S>[]> rings{new EventRing<T, S>[THREADS]}; // Too big for the stack
+  std::atomic<uint8_t> claimed{0};
+  std::atomic<uint32_t> dropped{0};
+};
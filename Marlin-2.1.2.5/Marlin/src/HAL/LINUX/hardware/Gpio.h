@@ -40,6 +40,8 @@ struct GpioEvent {
   pin_type pin_id;
   GpioEvent::Type event;
 
+  GpioEvent() : timestamp(0), pin_id(0), event(NOP) {}
+
   GpioEvent(uint64_t timestamp, pin_type pin_id, GpioEvent::Type event) {
     this->timestamp = timestamp;
     this->pin_id = pin_id;
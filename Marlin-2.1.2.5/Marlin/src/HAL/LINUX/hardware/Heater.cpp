@@ -23,38 +23,129 @@
 
 #include "Clock.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include "../../../inc/MarlinConfig.h"
 
 #include "Heater.h"
 
-Heater::Heater(pin_t heater, pin_t adc) {
-  heater_state = 0;
-  room_temp_raw = 150;
-  last = Clock::micros();
+// A 40W cartridge in a V6-style block, as in the MPC defaults
+const HeaterModel HeaterModel::hotend = { 40.0, 16.7, 0.068, 0.097, 5.6e-3, 0.22, 0.0, 0.0, 25.0, 0.0 };
+
+// A 220x220 aluminium bed with glass
+const HeaterModel HeaterModel::bed = { 180.0, 520.0, 1.3, 1.3, 0.0, 0.5, 0.0, 0.0, 25.0, 0.0 };
+
+void HeaterModel::parse(const char *spec) {
+  static const struct { const char *name; double HeaterModel::*field; } fields[] = {
+    { "power", &HeaterModel::power },
+    { "capacity", &HeaterModel::heat_capacity },
+    { "xfer", &HeaterModel::ambient_xfer },
+    { "xfer_fan", &HeaterModel::ambient_xfer_fan },
+    { "filament", &HeaterModel::filament_heat },
+    { "responsiveness", &HeaterModel::responsiveness },
+    { "cartridge", &HeaterModel::cartridge },
+    { "cartridge_xfer", &HeaterModel::cartridge_xfer },
+    { "ambient", &HeaterModel::ambient },
+    { "noise", &HeaterModel::noise }
+  };
+  while (spec && *spec) {
+    const char *eq = strchr(spec, '='), *end = strchr(spec, ',');
+    if (!end) end = spec + strlen(spec);
+    if (eq && eq < end) {
+      bool found = false;
+      for (auto &f : fields)
+        if (size_t(eq - spec) == strlen(f.name) && !strncmp(spec, f.name, eq - spec)) {
+          this->*f.field = atof(eq + 1);
+          found = true;
+        }
+      if (!found) fprintf(stderr, "Unknown heater model field: %.*s\n", int(eq - spec), spec);
+    }
+    spec = *end ? end + 1 : end;
+  }
+}
+
+Heater::Heater(pin_t heater, pin_t adc, const HeaterModel &model, const char *env) : model(model) {
+  if (env) this->model.parse(getenv(env));
   heater_pin = heater;
   adc_pin = adc;
-  heat = 0.0;
+  fan_pin = P_NC;
+  table = nullptr;
+  table_len = 0;
+  extruder = nullptr;
+  e_steps_per_mm = 1;
+  e_last = 0;
+  noise_seed = 0x9E3779B9 ^ heater;
+  cartridge_temp = block_temp = sensor_temp = this->model.ambient;
+  last = Clock::nanos();
+  heater_pwm.since = fan_pwm.since = last;
+  Gpio::attachPeripheral(heater_pin, this);
 }
 
 Heater::~Heater() {
 }
 
+// Invert the thermistor table, or fall back to a 100k / 4.7k pullup NTC
+uint16_t Heater::celsiusToAdc(double celsius) {
+  if (table && table_len > 1) {
+    const double scale = OV(1);
+    for (uint8_t i = 1; i < table_len; ++i) {
+      const double t0 = table[i - 1].celsius, t1 = table[i].celsius;
+      if ((celsius - t0) * (celsius - t1) <= 0 && t0 != t1)
+        return (table[i - 1].value + (table[i].value - table[i - 1].value) * (celsius - t0) / (t1 - t0)) / scale;
+    }
+    // Out of range, pin to the nearest end
+    const bool first = fabs(celsius - table[0].celsius) < fabs(celsius - table[table_len - 1].celsius);
+    return table[first ? 0 : table_len - 1].value / scale;
+  }
+  const double r = 100000.0 * exp(3950.0 * (1.0 / (celsius + 273.15) - 1.0 / 298.15));
+  return 1023.0 * r / (r + 4700.0);
+}
+
 void Heater::update() {
-  // crude pwm read and cruder heat simulation
-  auto now = Clock::micros();
-  double delta = (now - last);
-  if (delta > 1000 ) {
-    heater_state = pwmcap.update(0xFFFF * Gpio::pin_map[heater_pin].value);
-    last = now;
-    heat += (heater_state - heat) * (delta / 1000000000.0);
-
-    NOLESS(heat, room_temp_raw);
-    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = 0xFFFF - (uint16_t)heat;
+  const uint64_t now = Clock::nanos();
+  if (now - last < 1000000) return;
+
+  const double dt = (now - last) / 1000000000.0,
+               power = model.power * heater_pwm.take(now, last),
+               fan = fan_pin != P_NC ? fan_pwm.take(now, last) : 0;
+
+  double filament_mm = 0;
+  if (extruder) {
+    filament_mm = _MAX(0.0, (extruder->position - e_last) / e_steps_per_mm); // Ignore retraction
+    e_last = extruder->position;
+  }
+  last = now;
+
+  // Integrate in short steps, which keeps the sensor stage stable after a long wait
+  const double xfer = model.ambient_xfer + (model.ambient_xfer_fan - model.ambient_xfer) * fan,
+               fil_rate = filament_mm / dt;
+  const uint32_t steps = ceil(dt / 0.01);
+  const double h = dt / steps;
+  for (uint32_t i = 0; i < steps; ++i) {
+    double heat = power;
+    if (model.cartridge > 0) {
+      heat = model.cartridge_xfer * (cartridge_temp - block_temp);
+      cartridge_temp += h * (power - heat) / model.cartridge;
+    }
+    else
+      cartridge_temp = block_temp;
+    const double rise = block_temp - model.ambient;
+    block_temp += h * (heat - (xfer + model.filament_heat * fil_rate) * rise) / model.heat_capacity;
+    sensor_temp = model.responsiveness > 0 ? sensor_temp + _MIN(1.0, h * model.responsiveness) * (block_temp - sensor_temp) : block_temp;
+  }
+
+  double adc = celsiusToAdc(sensor_temp);
+  if (model.noise > 0) {
+    noise_seed ^= noise_seed << 13; noise_seed ^= noise_seed >> 17; noise_seed ^= noise_seed << 5;
+    adc += model.noise * (2.0 * noise_seed / double(UINT32_MAX) - 1.0);
   }
+  Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = uint16_t(constrain(lround(adc), 0L, 1023L)) << 2;
 }
 
 void Heater::interrupt(GpioEvent ev) {
-  // unused
+  if (ev.pin_id == heater_pin) heater_pwm.change(ev.timestamp, Gpio::pin_map[heater_pin].value);
+  else if (ev.pin_id == fan_pin) fan_pwm.change(ev.timestamp, Gpio::pin_map[fan_pin].value);
 }
 
 #endif // __PLAT_LINUX__
@@ -22,26 +22,89 @@
 #pragma once
 
 #include "Gpio.h"
+#include "LinearAxis.h"
+#include "../../../module/thermistor/thermistors.h"
 
-struct LowpassFilter {
-  uint64_t data_delay = 0;
-  uint16_t update(uint16_t value) {
-    data_delay += value - (data_delay >> 6);
-    return uint16_t(data_delay >> 6);
-  }
+/**
+ * Lumped thermal model of a heater block and its temperature sensor
+ *
+ *   C * dT/dt  = P * pwm - (h + (h_fan - h) * fan) * (T - T_amb) - c_fil * v_fil * (T - T_amb)
+ *       dTs/dt = r * (T - Ts)
+ *
+ * with the same units as the MPC settings, so M306 results can be compared
+ * with the plant directly. A responsiveness of 0 makes the sensor follow the
+ * block, giving a first-order plant.
+ *
+ * Optionally the heat goes through a cartridge with its own heat capacity
+ * first, which delays the effect of any power change as in a real hotend:
+ *
+ *   Cc * dTc/dt = P * pwm - k * (Tc - T)    (and P * pwm becomes k * (Tc - T) above)
+ *
+ * Any field can be overridden at startup with an environment variable like
+ *   MARLIN_SIM_HOTEND="power=50,capacity=20.5,noise=2"
+ */
+struct HeaterModel {
+  double power;             // (W) Heater power at full PWM
+  double heat_capacity;     // (J/K) Heat capacity of the block
+  double ambient_xfer;      // (W/K) Heat loss to ambient with the fan off
+  double ambient_xfer_fan;  // (W/K) Heat loss to ambient with the fan on full
+  double filament_heat;     // (J/K/mm) Heat capacity of extruded filament
+  double responsiveness;    // (K/s per K) Sensor response to the block, 0 = instant
+  double cartridge;         // (J/K) Heat capacity of the heater cartridge, 0 = part of the block
+  double cartridge_xfer;    // (W/K) Heat transfer from the cartridge to the block
+  double ambient;           // (°C) Room temperature, also the starting temperature
+  double noise;             // (ADC counts) Peak uniform noise added to each reading
+
+  void parse(const char *spec);
+
+  static const HeaterModel hotend, bed;
 };
 
 class Heater: public Peripheral {
 public:
-  Heater(pin_t heater, pin_t adc);
+  Heater(pin_t heater, pin_t adc, const HeaterModel &model, const char *env=nullptr);
   virtual ~Heater();
   void interrupt(GpioEvent ev);
   void update();
 
-  pin_t heater_pin, adc_pin;
-  uint16_t room_temp_raw;
-  uint16_t heater_state;
-  LowpassFilter pwmcap;
-  double heat;
+  // Convert with the firmware's own table so reported temperatures match the plant
+  void attachSensorTable(const temp_entry_t *table, uint8_t len) { this->table = table; table_len = len; }
+  void attachFan(pin_t fan) { fan_pin = fan; Gpio::attachPeripheral(fan_pin, this); }
+  // Negative steps/mm if the extruder's direction pin is inverted
+  void attachExtruder(LinearAxis *axis, double steps_per_mm) { extruder = axis; e_steps_per_mm = steps_per_mm; e_last = axis->position; }
+
+  HeaterModel model;
+  double cartridge_temp, block_temp, sensor_temp;
+
+private:
+  // Time-weighted average of a PWM pin's level since the last update
+  struct PwmAverage {
+    double level = 0, acc = 0;
+    uint64_t since = 0;
+    void change(uint64_t ts, uint16_t value) {
+      NOLESS(ts, since); // Set from another thread just before an update
+      acc += level * double(ts - since);
+      level = value > 1 ? value / 255.0 : value;
+      since = ts;
+    }
+    double take(uint64_t ts, uint64_t start) {
+      acc += level * double(ts - since);
+      const double avg = ts > start ? acc / double(ts - start) : level;
+      acc = 0;
+      since = ts;
+      return avg;
+    }
+  };
+
+  uint16_t celsiusToAdc(double celsius);
+
+  pin_t heater_pin, adc_pin, fan_pin;
+  PwmAverage heater_pwm, fan_pwm;
+  const temp_entry_t *table;
+  uint8_t table_len;
+  LinearAxis *extruder;
+  double e_steps_per_mm;
+  int32_t e_last;
+  uint32_t noise_seed;
   uint64_t last;
 };
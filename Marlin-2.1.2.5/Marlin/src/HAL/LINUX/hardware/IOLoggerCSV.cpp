@@ -32,17 +32,13 @@ IOLoggerCSV::~IOLoggerCSV() {
 }
 
 void IOLoggerCSV::log(GpioEvent ev) {
-  std::lock_guard<std::mutex> lock(vector_lock);
-  events.push_back(ev); //minimal impact to signal handler
+  events.push(ev); // lock-free, timer signals held off for the push
 }
 
 void IOLoggerCSV::flush() {
-  { std::lock_guard<std::mutex> lock(vector_lock);
-    while (!events.empty()) {
-      file << events.front().timestamp << ", "<< events.front().pin_id << ", " << events.front().event << std::endl;
-      events.pop_front();
-    }
-  }
+  events.drain([this](const GpioEvent &ev) {
+    file << ev.timestamp << ", " << ev.pin_id << ", " << ev.event << '\n';
+  });
   file.flush();
 }
 
@@ -21,10 +21,9 @@
  */
 #pragma once
 
-#include <mutex>
-#include <list>
 #include <fstream>
 #include "Gpio.h"
+#include "EventRing.h"
 
 class IOLoggerCSV: public IOLogger {
 public:
@@ -35,6 +34,5 @@ public:
 
 private:
   std::ofstream file;
-  std::list<GpioEvent> events;
-  std::mutex vector_lock;
+  ThreadEventRings<GpioEvent, 0x4000> events;
 };
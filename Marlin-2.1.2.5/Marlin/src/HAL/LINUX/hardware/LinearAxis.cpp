@@ -37,6 +37,8 @@ LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type en
   max_position = (200*80) + min_position;
   position = rand() % ((max_position - 40) - min_position) + (min_position + 20);
   last_update = Clock::nanos();
+  trace = nullptr;
+  trace_axis = 0;
 
   Gpio::attachPeripheral(step_pin, this);
 
@@ -55,6 +57,7 @@ void LinearAxis::interrupt(GpioEvent ev) {
     if (ev.event == GpioEvent::RISE) {
       last_update = ev.timestamp;
       position += -1 + 2 * Gpio::pin_map[dir_pin].value;
+      if (trace) trace->record(ev.timestamp, trace_axis, Gpio::pin_map[dir_pin].value);
       Gpio::pin_map[min_pin].value = (position < min_position);
       //Gpio::pin_map[max_pin].value = (position > max_position);
       //if (position < min_position) printf("axis(%d) endstop : pos: %d, mm: %f, min: %d\n", step_pin, position, position / 80.0, Gpio::pin_map[min_pin].value);
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include "Gpio.h"
+#include "StepTrace.h"
 
 class LinearAxis: public Peripheral {
 public:
@@ -30,6 +31,7 @@ public:
   virtual ~LinearAxis();
   void update();
   void interrupt(GpioEvent ev);
+  void attachTrace(StepTrace *trace, uint8_t axis) { this->trace = trace; trace_axis = axis; }
 
   pin_type enable_pin;
   pin_type dir_pin;
@@ -42,4 +44,7 @@ public:
   int32_t max_position;
   uint64_t last_update;
 
+  StepTrace *trace;
+  uint8_t trace_axis;
+
 };
@@ -0,0 +1,71 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <algorithm>
+#include <string.h>
+#include <stdio.h>
+#include "StepTrace.h"
+
+StepTrace::StepTrace(std::string filename, const char *axis_names) {
+  file.open(filename, std::ios::binary);
+  const uint8_t axes = strlen(axis_names);
+  const char header[] = { 'M', 'S', 'T', 'R', 1, char(axes) };
+  file.write(header, sizeof(header));
+  file.write(axis_names, axes);
+  last_timestamp = 0;
+}
+
+StepTrace::~StepTrace() {
+  flush();
+  if (events.getDropped()) printf("step trace: %u events dropped\n", events.getDropped());
+  file.close();
+}
+
+void StepTrace::encode(uint64_t value) {
+  do {
+    const uint8_t b = value & 0x7F;
+    value >>= 7;
+    out.push_back(value ? b | 0x80 : b);
+  } while (value);
+}
+
+void StepTrace::flush() {
+  events.drain([this](const StepEvent &ev) { batch.push_back(ev); });
+  if (batch.empty()) return;
+
+  // Events from different threads interleave, so put them back in time order
+  std::stable_sort(batch.begin(), batch.end(), [](const StepEvent &a, const StepEvent &b) { return a.timestamp < b.timestamp; });
+
+  for (const StepEvent &ev : batch) {
+    const int64_t delta = int64_t(ev.timestamp - last_timestamp);
+    const uint64_t zigzag = (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+    encode((zigzag << 4) | ((ev.axis & 0x7) << 1) | (ev.dir & 1));
+    last_timestamp = ev.timestamp;
+  }
+  batch.clear();
+
+  file.write((const char*)out.data(), out.size());
+  out.clear();
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,69 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "EventRing.h"
+
+/**
+ * Binary step trace
+ *
+ * Records every step edge (timestamp, axis, direction) without locks and
+ * writes it out as a compact delta-encoded stream, so whole prints can be
+ * captured without the logging itself distorting step timing.
+ *
+ * File layout:
+ *   "MSTR" magic, uint8 version, uint8 axis count, one name char per axis
+ *   then one LEB128 varint per step: zigzag(Δt ns) << 4 | axis << 1 | dir
+ *
+ * Decode with buildroot/share/scripts/decode_step_trace.py
+ */
+
+struct StepEvent {
+  uint64_t timestamp;
+  uint8_t axis, dir;
+};
+
+class StepTrace {
+public:
+  StepTrace(std::string filename, const char *axis_names);
+  ~StepTrace();
+
+  // Producer side, called from the stepping context
+  void record(uint64_t timestamp, uint8_t axis, bool dir) {
+    events.push({ timestamp, axis, uint8_t(dir) });
+  }
+
+  // Consumer side, encode and write everything recorded so far
+  void flush();
+
+private:
+  void encode(uint64_t value);
+
+  std::ofstream file;
+  ThreadEventRings<StepEvent, 0x10000> events;
+  std::vector<StepEvent> batch;
+  std::vector<uint8_t> out;
+  uint64_t last_timestamp;
+};
@@ -50,6 +50,8 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
   frequency = sim_freq;
   cbfn = fn;
 
+  if (Clock::isVirtualTime()) return; // Fired by the virtual time scheduler, no signals needed
+
   sa.sa_flags = SA_SIGINFO;
   sa.sa_sigaction = Timer::handler;
   sigemptyset(&sa.sa_mask);
@@ -71,12 +73,13 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
 }
 
 void Timer::start(uint32_t frequency) {
+  if (Clock::isVirtualTime()) this->start_time = Clock::nanos();
   setCompare(this->frequency / frequency);
   //printf("timer(%ld) started\n", getID());
 }
 
 void Timer::enable() {
-  if (sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
+  if (!Clock::isVirtualTime() && sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
   active = true;
@@ -84,13 +87,20 @@ void Timer::enable() {
 }
 
 void Timer::disable() {
-  if (sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
+  if (!Clock::isVirtualTime() && sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
   active = false;
 }
 
 void Timer::setCompare(uint32_t compare) {
+  if (Clock::isVirtualTime()) {
+    // The count runs from the last compare match, so the ISR can reprogram the period without drift
+    this->compare = compare;
+    this->period = Clock::ticksToNanos(compare, frequency);
+    return;
+  }
+
   uint32_t nsec_offset = 0;
   if (active) {
     nsec_offset = Clock::nanos() - this->start_time; // calculate how long the timer would have been running for
@@ -113,7 +123,14 @@ void Timer::setCompare(uint32_t compare) {
   this->start_time = Clock::nanos();
 }
 
+void Timer::fire() {
+  this->start_time = Clock::nanos();
+  cbfn();
+}
+
 uint32_t Timer::getCount() {
+  // Reading the counter takes a tick, so code waiting on the count (e.g., step pulse timing) moves on
+  if (Clock::isVirtualTime()) Clock::advanceTo(Clock::nanos() + Clock::ticksToNanos(1, frequency));
   return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
 }
 
@@ -48,6 +48,10 @@ public:
   uint32_t getOverruns() {return overruns;}
   uint32_t getAvgError() {return avg_error;}
 
+  // Virtual time: absolute time of the next compare match, 0 if none is pending
+  uint64_t nextEvent() { return (active && period) ? start_time + period : 0; }
+  void fire();
+
   intptr_t getID() {
     return (*(intptr_t*)timerid);
   }
@@ -26,54 +26,11 @@
   #include "../../../feature/e_parser.h"
 #endif
 #include "../../../core/serial_hook.h"
+#include "../../../libs/spsc_ring.h"
 
 #include <stdarg.h>
 #include <stdio.h>
 
-/**
- * Generic RingBuffer
- * T type of the buffer array
- * S size of the buffer (must be power of 2)
- */
-template <typename T, uint32_t S> class RingBuffer {
-public:
-  RingBuffer() { index_read = index_write = 0; }
-  uint32_t available() volatile { return index_write - index_read; }
-  uint32_t free() volatile      { return buffer_size - available(); }
-  bool empty() volatile         { return index_read == index_write; }
-  bool full() volatile          { return available() == buffer_size; }
-  void clear() volatile         { index_read = index_write = 0; }
-
-  bool peek(T *value) volatile {
-    if (value == 0 || available() == 0)
-      return false;
-    *value = buffer[mask(index_read)];
-    return true;
-  }
-
-  int read() volatile {
-    if (empty()) return -1;
-    return buffer[mask(index_read++)];
-  }
-
-  bool write(T value) volatile {
-    if (full()) return false;
-    buffer[mask(index_write++)] = value;
-    return true;
-  }
-
-private:
-  uint32_t mask(uint32_t val) volatile {
-    return buffer_mask & val;
-  }
-
-  static const uint32_t buffer_size = S;
-  static const uint32_t buffer_mask = buffer_size - 1;
-  volatile T buffer[buffer_size];
-  volatile uint32_t index_write;
-  volatile uint32_t index_read;
-};
-
 struct HalSerial {
   HalSerial() { host_connected = true; }
 
@@ -81,22 +38,29 @@ struct HalSerial {
   void end()          {}
 
   int peek() {
+    const uint8_t * const value = receive_buffer.peek();
+    return value ? *value : -1;
+  }
+
+  int read() {
     uint8_t value;
-    return receive_buffer.peek(&value) ? value : -1;
+    return receive_buffer.pop(value) ? value : -1;
   }
 
-  int read() { return receive_buffer.read(); }
+  int readBuffer(uint8_t * const buf, const int len) {
+    return receive_buffer.pop(buf, _MIN(len, receive_buffer.size()));
+  }
 
   size_t write(char c) {
     if (!host_connected) return 0;
-    while (!transmit_buffer.free());
-    return transmit_buffer.write(c);
+    while (transmit_buffer.full());
+    return transmit_buffer.push(c);
   }
 
   bool connected() { return host_connected; }
 
   uint16_t available() {
-    return (uint16_t)receive_buffer.available();
+    return (uint16_t)receive_buffer.count();
   }
 
   void flush() { receive_buffer.clear(); }
@@ -107,11 +71,13 @@ struct HalSerial {
 
   void flushTX() {
     if (host_connected)
-      while (transmit_buffer.available()) { /* nada */ }
+      while (!transmit_buffer.empty()) { /* nada */ }
   }
 
-  volatile RingBuffer<uint8_t, 128> receive_buffer;
-  volatile RingBuffer<uint8_t, 128> transmit_buffer;
+  // Filled by the stdin thread, drained by Marlin
+  SPSCRing<uint8_t, 128> receive_buffer;
+  // Filled by Marlin, drained by the stdout thread
+  SPSCRing<uint8_t, 128> transmit_buffer;
   volatile bool host_connected;
 };
 
@@ -23,10 +23,12 @@
 #ifdef __PLAT_LINUX__
 
 //#define GPIO_LOGGING // Full GPIO and Positional Logging
+//#define STEP_TRACE   // Binary step trace of every axis, see hardware/StepTrace.h
 
 #include "../../inc/MarlinConfig.h"
 #include "../shared/Delay.h"
 #include "hardware/IOLoggerCSV.h"
+#include "hardware/StepTrace.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
 
@@ -42,9 +44,8 @@ extern void loop();
 // simple stdout / stdin implementation for fake serial port
 void write_serial_thread() {
   for (;;) {
-    for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
-      fputc(usb_serial.transmit_buffer.read(), stdout);
-    }
+    for (uint8_t c; usb_serial.transmit_buffer.pop(c);)
+      fputc(c, stdout);
     std::this_thread::yield();
   }
 }
@@ -55,31 +56,56 @@ void read_serial_thread() {
     std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
     if (fgets(buffer, len, stdin))
       for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
+        usb_serial.receive_buffer.push(buffer[i]);
     std::this_thread::yield();
   }
 }
 
-void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
-  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+class SimulatedHardware {
+public:
+  Heater hotend{HEATER_0_PIN, TEMP_0_PIN, HeaterModel::hotend, "MARLIN_SIM_HOTEND"};
+  Heater bed{HEATER_BED_PIN, TEMP_BED_PIN, HeaterModel::bed, "MARLIN_SIM_BED"};
+  LinearAxis x_axis{X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN};
+  LinearAxis y_axis{Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN};
+  LinearAxis z_axis{Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN};
+  LinearAxis extruder0{E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC};
 
   #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
-
+    IOLoggerCSV logger{"all_gpio_log.csv"};
     std::ofstream position_log;
-    position_log.open("axis_position_log.csv");
-
     int32_t x,y,z;
   #endif
 
-  for (;;) {
+  #ifdef STEP_TRACE
+    StepTrace trace{"step_trace.bin", "XYZE"};
+  #endif
+
+  SimulatedHardware() {
+    hotend.attachSensorTable(TEMPTABLE_0, TEMPTABLE_0_LEN);
+    #ifdef TEMPTABLE_BED
+      bed.attachSensorTable(TEMPTABLE_BED, TEMPTABLE_BED_LEN);
+    #endif
+    #if HAS_FAN0
+      hotend.attachFan(FAN0_PIN);
+    #endif
+    #if HAS_EXTRUDERS
+      constexpr float steps_per_mm[] = DEFAULT_AXIS_STEPS_PER_UNIT;
+      hotend.attachExtruder(&extruder0, TERN(INVERT_E0_DIR, -1, 1) * steps_per_mm[E_AXIS]);
+    #endif
 
+    #ifdef GPIO_LOGGING
+      Gpio::attachLogger(&logger);
+      position_log.open("axis_position_log.csv");
+    #endif
+    #ifdef STEP_TRACE
+      x_axis.attachTrace(&trace, 0);
+      y_axis.attachTrace(&trace, 1);
+      z_axis.attachTrace(&trace, 2);
+      extruder0.attachTrace(&trace, 3);
+    #endif
+  }
+
+  void update() {
     hotend.update();
     bed.update();
 
@@ -91,8 +117,7 @@ void simulation_loop() {
     #ifdef GPIO_LOGGING
       if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
         uint64_t update = _MAX(x_axis.last_update, y_axis.last_update, z_axis.last_update);
-        position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
-        position_log.flush();
+        position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << '\n';
         x = x_axis.position;
         y = y_axis.position;
         z = z_axis.position;
@@ -101,10 +126,32 @@ void simulation_loop() {
       logger.flush();
     #endif
 
+    #ifdef STEP_TRACE
+      trace.flush();
+    #endif
+  }
+};
+
+void simulation_loop() {
+  SimulatedHardware hardware;
+  for (;;) {
+    hardware.update();
     std::this_thread::yield();
   }
 }
 
+#if ENABLED(VIRTUAL_TIME)
+
+  SimulatedHardware *virtual_hardware = nullptr;
+
+  // Called wherever the firmware would otherwise spin: let time move on to the next event
+  void virtual_time_yield() {
+    HAL_timer_yield();
+    virtual_hardware->update();
+  }
+
+#endif
+
 int main() {
   std::thread write_serial (write_serial_thread);
   std::thread read_serial (read_serial_thread);
@@ -118,19 +165,37 @@ int main() {
   Clock::setFrequency(F_CPU);
   Clock::setTimeMultiplier(1.0); // some testing at 10x
 
-  HAL_timer_init();
+  #if ENABLED(VIRTUAL_TIME)
+    // Hardware and timers are all driven from this thread, so runs are repeatable
+    Clock::setVirtualTime(true);
+    HAL_timer_init();
 
-  std::thread simulation (simulation_loop);
+    SimulatedHardware hardware;
+    virtual_hardware = &hardware;
 
-  DELAY_US(10000);
+    DELAY_US(10000);
 
-  setup();
-  for (;;) {
-    loop();
-    std::this_thread::yield();
-  }
+    setup();
+    for (;;) {
+      loop();
+      virtual_time_yield();
+    }
+  #else
+    HAL_timer_init();
+
+    std::thread simulation (simulation_loop);
+
+    DELAY_US(10000);
+
+    setup();
+    for (;;) {
+      loop();
+      std::this_thread::yield();
+    }
+
+    simulation.join();
+  #endif
 
-  simulation.join();
   write_serial.join();
   read_serial.join();
 }
@@ -28,6 +28,9 @@
 /**
  * Use POSIX signals to attempt to emulate Interrupts
  * This has many limitations and is not fit for the purpose
+ *
+ * With virtual time the timers are instead fired synchronously whenever
+ * the firmware would wait, so no interrupt is ever late or overrun.
  */
 
 HAL_STEP_TIMER_ISR();
@@ -38,6 +41,43 @@ Timer timers[2];
 void HAL_timer_init() {
   timers[0].init(0, STEPPER_TIMER_RATE, TIMER0_IRQHandler);
   timers[1].init(1, TEMP_TIMER_RATE, TIMER1_IRQHandler);
+  if (Clock::isVirtualTime()) Clock::setSleepHandler(HAL_timer_advance);
+}
+
+/**
+ * Virtual time scheduler
+ * Instead of sleeping, run every enabled timer interrupt that falls due before
+ * the target time in timestamp order, moving the clock to each one in turn.
+ * Delays made from inside an interrupt only consume time.
+ */
+static bool in_isr = false;
+
+void HAL_timer_advance(const uint64_t until_ns) {
+  if (in_isr) return Clock::advanceTo(until_ns);
+
+  for (;;) {
+    Timer *next = nullptr;
+    for (Timer &t : timers)
+      if (t.nextEvent() && (!next || t.nextEvent() < next->nextEvent())) next = &t;
+    if (!next || next->nextEvent() > until_ns) break;
+    Clock::advanceTo(next->nextEvent());
+    in_isr = true;
+    next->fire();
+    in_isr = false;
+  }
+  Clock::advanceTo(until_ns);
+}
+
+// Skip idle time by jumping straight to the next timer event (at most 1ms ahead)
+void HAL_timer_yield() {
+  uint64_t until_ns = Clock::nanos() + 1000000UL;
+  for (Timer &t : timers) if (t.nextEvent()) NOMORE(until_ns, t.nextEvent());
+  HAL_timer_advance(until_ns);
+}
+
+// Reading the clock outside of an interrupt costs a little time, so loops polling millis() still time out
+void HAL_timer_poll() {
+  if (!in_isr) HAL_timer_advance(Clock::nanos() + 1000UL);
 }
 
 void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
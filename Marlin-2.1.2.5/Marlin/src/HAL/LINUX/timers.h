@@ -93,5 +93,10 @@ void HAL_timer_enable_interrupt(const uint8_t timer_num);
 void HAL_timer_disable_interrupt(const uint8_t timer_num);
 bool HAL_timer_interrupt_enabled(const uint8_t timer_num);
 
+// Virtual time (see VIRTUAL_TIME in Configuration_adv.h)
+void HAL_timer_advance(const uint64_t until_ns);
+void HAL_timer_yield();
+void HAL_timer_poll();
+
 #define HAL_timer_isr_prologue(T) NOOP
 #define HAL_timer_isr_epilogue(T) NOOP
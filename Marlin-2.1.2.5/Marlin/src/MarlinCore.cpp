@@ -117,6 +117,10 @@
   #include "feature/max7219.h"
 #endif
 
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #include "feature/move_merge.h"
+#endif
+
 #if HAS_COLOR_LEDS
   #include "feature/leds/leds.h"
 #endif
@@ -421,7 +425,14 @@ inline void manage_inactivity(const bool no_stepper_sleep=false) {
   if (gcode.stepper_max_timed_out(ms)) {
     SERIAL_ERROR_START();
     SERIAL_ECHOPGM(STR_KILL_PRE);
-    SERIAL_ECHOLNPGM(STR_KILL_INACTIVE_TIME, parser.command_ptr);
+    SERIAL_ECHOPGM(STR_KILL_INACTIVE_TIME);
+    #if HAS_PREPARSED_GCODE
+      if (parser.preparsed)
+        parser.echo_preparsed(parser.command_ptr);
+      else
+    #endif
+        SERIAL_ECHO(parser.command_ptr);
+    SERIAL_EOL();
     kill();
   }
 
@@ -835,6 +846,9 @@ void idle(const bool no_stepper_sleep/*=false*/) {
   // Announce Host Keepalive state (if any)
   TERN_(HOST_KEEPALIVE_FEATURE, gcode.host_keepalive());
 
+  // Send acknowledgements held back too long
+  TERN_(SERIAL_WINDOWED_OK, queue.ack_task());
+
   // Update the Print Job Timer state
   TERN_(PRINTCOUNTER, print_job_timer.tick());
 
@@ -1290,7 +1304,7 @@ void setup() {
     );
   #endif
   SERIAL_ECHO_MSG(" Compiled: " __DATE__);
-  SERIAL_ECHO_MSG(STR_FREE_MEMORY, hal.freeMemory(), STR_PLANNER_BUFFER_BYTES, sizeof(block_t) * (BLOCK_BUFFER_SIZE));
+  SERIAL_ECHO_MSG(STR_FREE_MEMORY, hal.freeMemory(), STR_PLANNER_BUFFER_BYTES, (sizeof(block_t) + TERN0(PLANNER_SPLIT_BLOCK, sizeof(block_plan_t))) * (BLOCK_BUFFER_SIZE));
 
   // Some HAL need precise delay adjustment
   calibrate_delay_loop();
@@ -1329,8 +1343,8 @@ void setup() {
     #endif
   #endif
 
-  #if HAS_MEDIA && ANY(SDCARD_EEPROM_EMULATION, POWER_LOSS_RECOVERY)
-    SETUP_RUN(card.mount());          // Mount media with settings before first_load
+  #if HAS_MEDIA && ANY(SDCARD_EEPROM_EMULATION, POWER_LOSS_RECOVERY, MESH_STORE_SDCARD)
+    SETUP_RUN(card.mount());          // Mount media with settings or meshes before first_load
   #endif
 
   SETUP_RUN(settings.first_load());   // Load data from EEPROM if available (or use defaults)
@@ -1678,6 +1692,11 @@ void loop() {
 
     queue.advance();
 
+    #if ENABLED(MERGE_COLLINEAR_MOVES)
+      // Don't hold a move back when no command is waiting to extend it
+      if (!queue.has_commands_queued() || !planner.has_blocks_queued()) move_merge.flush();
+    #endif
+
     #if ANY(POWER_OFF_TIMER, POWER_OFF_WAIT_FOR_COOLDOWN)
       powerManager.checkAutoPowerOff();
     #endif
@@ -71,6 +71,7 @@ ENUM_FLAGS(SerialFeature);
 CALL_IF_EXISTS_IMPL(void, flushTX);
 CALL_IF_EXISTS_IMPL(bool, connected, true);
 CALL_IF_EXISTS_IMPL(SerialFeature, features, SerialFeature::None);
+CALL_IF_EXISTS_IMPL(int, readBuffer, -1);
 
 // A simple forward struct to prevent the compiler from selecting print(double, int) as a default overload
 // for any type other than double/float. For double/float, a conversion exists so the call will be invisible.
@@ -121,6 +122,21 @@ struct SerialBase {
       @param index  The port index, usually 0 */
   int read(serial_index_t index=0)        { return SerialChild->read(index); }
 
+  /** Read up to 'len' bytes from the port, without waiting for more
+      Ports with no readBuffer method are read one byte at a time.
+      @param index  The port index, usually 0
+      @return The number of bytes read */
+  int readBlock(uint8_t * const buf, const int len, serial_index_t index=0) {
+    int n = CALL_IF_EXISTS(int, SerialChild, readBuffer, buf, len, index);
+    if (n < 0)
+      for (n = 0; n < len; ++n) {
+        const int c = read(index);
+        if (c < 0) break;
+        buf[n] = c;
+      }
+    return n;
+  }
+
   /** Combine the features of this serial instance and return it
       @param index  The port index, usually 0 */
   SerialFeature features(serial_index_t index=0) const { return static_cast<const Child*>(this)->features(index);  }
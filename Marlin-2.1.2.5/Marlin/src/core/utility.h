@@ -35,15 +35,16 @@ void safe_delay(millis_t ms);           // Delay ensuring that temperatures are
 
 #if GRID_MAX_POINTS
 
-  // 16x16 bit arrays
+  // WxH bit arrays, with rows of up to 64 bits
   template <int W, int H>
   struct FlagBits {
-    bits_t(W) flags[H];
+    typedef bits_t(W) row_t;
+    row_t flags[H];
     void fill()                                   { memset(flags, 0xFF, sizeof(flags)); }
     void reset()                                  { memset(flags, 0x00, sizeof(flags)); }
-    void unmark(const uint8_t x, const uint8_t y) { CBI(flags[y], x); }
-    void mark(const uint8_t x, const uint8_t y)   { SBI(flags[y], x); }
-    bool marked(const uint8_t x, const uint8_t y) { return TEST(flags[y], x); }
+    void unmark(const uint8_t x, const uint8_t y) { flags[y] &= ~(row_t(1) << x); }
+    void mark(const uint8_t x, const uint8_t y)   { flags[y] |= row_t(1) << x; }
+    bool marked(const uint8_t x, const uint8_t y) { return !!(flags[y] & (row_t(1) << x)); }
     inline void unmark(const xy_int8_t &xy)       { unmark(xy.x, xy.y); }
     inline void mark(const xy_int8_t &xy)         { mark(xy.x, xy.y); }
     inline bool marked(const xy_int8_t &xy)       { return marked(xy.x, xy.y); }
@@ -0,0 +1,183 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(RESONANCE_TEST)
+
+#include "accelerometer.h"
+
+Accelerometer accelerometer;
+
+uint16_t Accelerometer::late, Accelerometer::overruns;
+
+// The ADXL345 FIFO holds 32 samples. Reads are counted late from 3/4 full.
+#define ACCEL_FIFO_SIZE      32
+#define ACCEL_FIFO_WATERMARK 24
+
+#ifdef __PLAT_LINUX__
+
+  #include <stdio.h>
+
+  static FILE *accel_file;        // = nullptr
+  static bool at_marker;          // The '#' line of the next frequency was read
+  static millis_t start_ms;
+  static uint32_t served;         // Samples read since start()
+
+  bool Accelerometer::begin() {
+    end();
+    accel_file = fopen(RESONANCE_ACCEL_FILE, "r");
+    at_marker = false;
+    late = overruns = 0;
+    return accel_file != nullptr;
+  }
+
+  void Accelerometer::start() {
+    // Skip what is left of the previous frequency
+    char line[64];
+    while (!at_marker && fgets(line, sizeof(line), accel_file))
+      at_marker = line[0] == '#';
+    at_marker = false;
+    start_ms = millis();
+    served = 0;
+  }
+
+  uint8_t Accelerometer::read(accel_sample_t samples[], const uint8_t max) {
+    // Hand out samples no faster than a real device would
+    const uint32_t due = uint64_t(millis() - start_ms) * (RESONANCE_SAMPLE_RATE) / 1000UL;
+    uint8_t n = 0;
+    char line[64];
+
+    if (at_marker || feof(accel_file)) return 0;  // No more samples for this frequency
+
+    // Drop what a real FIFO would have lost by now
+    if (due - served > ACCEL_FIFO_SIZE) {
+      ++overruns;
+      while (due - served > ACCEL_FIFO_SIZE && !at_marker && fgets(line, sizeof(line), accel_file)) {
+        if (line[0] == '#') at_marker = true; else served++;
+      }
+    }
+    else if (due - served >= ACCEL_FIFO_WATERMARK)
+      ++late;
+
+    while (n < max && served < due && !at_marker && fgets(line, sizeof(line), accel_file)) {
+      if (line[0] == '#') { at_marker = true; break; }
+      accel_sample_t &s = samples[n];
+      if (sscanf(line, "%f %f %f", &s.x, &s.y, &s.z) == 3) { n++; served++; }
+    }
+    return n;
+  }
+
+  void Accelerometer::end() {
+    if (accel_file) { fclose(accel_file); accel_file = nullptr; }
+  }
+
+#else
+
+  #include HAL_PATH(.., MarlinSPI.h)
+
+  // ADXL345 registers
+  #define ADXL345_DEVID       0x00
+  #define ADXL345_BW_RATE     0x2C
+  #define ADXL345_POWER_CTL   0x2D
+  #define ADXL345_INT_SOURCE  0x30
+  #define ADXL345_DATA_FORMAT 0x31
+  #define ADXL345_DATAX0      0x32
+  #define ADXL345_FIFO_CTL    0x38
+  #define ADXL345_FIFO_STATUS 0x39
+
+  #define ADXL345_READ        0x80
+  #define ADXL345_MULTI       0x40
+
+  // Full resolution mode is 3.9mg per bit at every range
+  constexpr float adxl345_mm_s2 = 0.0039f * 9806.65f;
+
+  // The ADXL345 can go up to 5MHz in SPI mode 3
+  static SPISettings adxl345_spi = SPISettings(
+    TERN(TARGET_LPC1768, SPI_QUARTER_SPEED, TERN(ARDUINO_ARCH_STM32, SPI_CLOCK_DIV4, 4000000)),
+    MSBFIRST,
+    SPI_MODE3 // CPOL1 CPHA1
+  );
+
+  static void adxl345_transfer(const uint8_t reg, uint8_t data[], const uint8_t n) {
+    SPI.beginTransaction(adxl345_spi);
+    WRITE(ADXL345_CS_PIN, LOW);
+    SPI.transfer(reg);
+    for (uint8_t i = 0; i < n; ++i) data[i] = SPI.transfer(data[i]);
+    WRITE(ADXL345_CS_PIN, HIGH);
+    SPI.endTransaction();
+  }
+
+  static void adxl345_write(const uint8_t reg, uint8_t value) { adxl345_transfer(reg, &value, 1); }
+
+  static uint8_t adxl345_read(const uint8_t reg) {
+    uint8_t value = 0;
+    adxl345_transfer(reg | ADXL345_READ, &value, 1);
+    return value;
+  }
+
+  bool Accelerometer::begin() {
+    OUT_WRITE(ADXL345_CS_PIN, HIGH);
+    SPI.begin();
+    if (adxl345_read(ADXL345_DEVID) != 0xE5) return false;
+    late = overruns = 0;
+
+    // Output data rate codes go down by one for each halving from 3200Hz
+    constexpr uint8_t rate_code = (RESONANCE_SAMPLE_RATE) == 3200 ? 0x0F : (RESONANCE_SAMPLE_RATE) == 1600 ? 0x0E
+                                : (RESONANCE_SAMPLE_RATE) == 800 ? 0x0D : 0x0C;
+    adxl345_write(ADXL345_POWER_CTL, 0x00);       // Standby while setting up
+    adxl345_write(ADXL345_DATA_FORMAT, 0x0B);     // Full resolution, ±16g
+    adxl345_write(ADXL345_BW_RATE, rate_code);
+    return true;
+  }
+
+  void Accelerometer::start() {
+    adxl345_write(ADXL345_FIFO_CTL, 0x00);        // Bypass mode empties the FIFO
+    adxl345_write(ADXL345_FIFO_CTL, 0x80 | ACCEL_FIFO_WATERMARK); // Stream mode keeps the latest 32 samples
+    adxl345_write(ADXL345_POWER_CTL, 0x08);       // Measure
+  }
+
+  uint8_t Accelerometer::read(accel_sample_t samples[], const uint8_t max) {
+    // Overrun is set once the full FIFO has dropped a sample, Watermark from 3/4 full.
+    // Both clear as the FIFO is read.
+    const uint8_t source = adxl345_read(ADXL345_INT_SOURCE);
+    if (TEST(source, 0)) ++overruns;
+    else if (TEST(source, 1)) ++late;
+
+    const uint8_t n = _MIN(adxl345_read(ADXL345_FIFO_STATUS) & 0x3F, max);
+    for (uint8_t i = 0; i < n; ++i) {
+      uint8_t raw[6] = { 0 };
+      adxl345_transfer(ADXL345_DATAX0 | ADXL345_READ | ADXL345_MULTI, raw, 6);
+      samples[i].x = int16_t(raw[1] << 8 | raw[0]) * adxl345_mm_s2;
+      samples[i].y = int16_t(raw[3] << 8 | raw[2]) * adxl345_mm_s2;
+      samples[i].z = int16_t(raw[5] << 8 | raw[4]) * adxl345_mm_s2;
+    }
+    return n;
+  }
+
+  void Accelerometer::end() {
+    adxl345_write(ADXL345_POWER_CTL, 0x00);       // Standby
+  }
+
+#endif
+
+#endif // RESONANCE_TEST
@@ -0,0 +1,62 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/accelerometer.h - Acceleration samples for the resonance test
+ *
+ * On a printer this is an ADXL345 on the hardware SPI bus. Its 32-sample
+ * FIFO is drained by read(), so read() must be called at least every
+ * 32 / RESONANCE_SAMPLE_RATE seconds while sampling. Each read() checks the
+ * FIFO status and counts the times it was found past its watermark or had
+ * already lost samples.
+ *
+ * The native target replays RESONANCE_ACCEL_FILE in real time instead.
+ * The file holds one "x y z" line per sample in mm/s². A line starting with
+ * '#' goes before the samples of each test frequency, so every frequency
+ * starts at its own samples no matter how long the previous one ran.
+ * Samples that would no longer fit in the FIFO are skipped, as on a device.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+struct accel_sample_t { float x, y, z; };
+
+class Accelerometer {
+public:
+  static uint16_t late,       // Reads that found the FIFO at or past its watermark
+                  overruns;   // Reads that found samples already lost
+
+  // Set up the device and clear the counts. False if it doesn't respond.
+  static bool begin();
+
+  // Discard old samples and start sampling the next test frequency
+  static void start();
+
+  // Read up to 'max' waiting samples in mm/s². Returns the number read.
+  static uint8_t read(accel_sample_t samples[], const uint8_t max);
+
+  // Stop sampling
+  static void end();
+};
+
+extern Accelerometer accelerometer;
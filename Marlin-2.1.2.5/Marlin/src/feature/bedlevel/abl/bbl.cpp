@@ -256,13 +256,6 @@ void LevelingBilinear::print_leveling_grid(const bed_mesh_t* _z_values/*=nullptr
 
 #endif // ABL_BILINEAR_SUBDIVISION
 
-// Refresh after other values have been updated
-void LevelingBilinear::refresh_bed_level() {
-  TERN_(ABL_BILINEAR_SUBDIVISION, subdivide_mesh());
-  cached_rel.x = cached_rel.y = -999.999;
-  cached_g.x = cached_g.y = -99;
-}
-
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
   #define ABL_BG_SPACING(A) grid_spacing_virt.A
   #define ABL_BG_FACTOR(A)  grid_factor_virt.A
@@ -277,9 +270,55 @@ void LevelingBilinear::refresh_bed_level() {
   #define ABL_BG_GRID(X,Y)  z_values[X][Y]
 #endif
 
+#if ENABLED(MESH_CELL_CACHE)
+
+  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+    mesh_cell_t LevelingBilinear::cells[ABL_GRID_POINTS_VIRT_X - 1][ABL_GRID_POINTS_VIRT_Y - 1];
+  #else
+    mesh_cell_t LevelingBilinear::cells[GRID_MAX_CELLS_X][GRID_MAX_CELLS_Y];
+  #endif
+
+  // Precompute the bilinear coefficients of every (virtual) grid cell
+  void LevelingBilinear::refresh_cells() {
+    for (uint8_t x = 0; x < ABL_BG_POINTS_X - 1; ++x)
+      for (uint8_t y = 0; y < ABL_BG_POINTS_Y - 1; ++y)
+        cells[x][y].set(ABL_BG_GRID(x, y), ABL_BG_GRID(x + 1, y), ABL_BG_GRID(x, y + 1), ABL_BG_GRID(x + 1, y + 1));
+  }
+
+#endif
+
+// Refresh after other values have been updated
+void LevelingBilinear::refresh_bed_level() {
+  TERN_(ABL_BILINEAR_SUBDIVISION, subdivide_mesh());
+  TERN_(MESH_CELL_CACHE, refresh_cells());
+  cached_rel.x = cached_rel.y = -999.999;
+  cached_g.x = cached_g.y = -99;
+}
+
 // Get the Z adjustment for non-linear bed leveling
 float LevelingBilinear::get_z_correction(const xy_pos_t &raw) {
 
+  #if ENABLED(MESH_CELL_CACHE)
+
+    // Position in grid units. The whole part picks the cell, the fraction is the position in the cell.
+    xy_float_t ratio = { (raw.x - grid_start.x) * ABL_BG_FACTOR(x), (raw.y - grid_start.y) * ABL_BG_FACTOR(y) };
+    const xy_int8_t g = {
+      int8_t(constrain(FLOOR(ratio.x), 0, ABL_BG_POINTS_X - 2)),
+      int8_t(constrain(FLOOR(ratio.y), 0, ABL_BG_POINTS_Y - 2))
+    };
+    ratio.x -= g.x;
+    ratio.y -= g.y;
+
+    #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
+      // Beyond the grid maintain height at grid edges
+      LIMIT(ratio.x, 0, 1);
+      LIMIT(ratio.y, 0, 1);
+    #endif
+
+    return cells[g.x][g.y].z(ratio);
+
+  #else
+
   static float z1, d2, z3, d4, L, D;
 
   static xy_pos_t ratio;
@@ -359,6 +398,8 @@ float LevelingBilinear::get_z_correction(const xy_pos_t &raw) {
   //*/
 
   return offset;
+
+  #endif // !MESH_CELL_CACHE
 }
 
 #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
@@ -49,6 +49,15 @@ private:
     static void subdivide_mesh();
   #endif
 
+  #if ENABLED(MESH_CELL_CACHE)
+    #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+      static mesh_cell_t cells[ABL_GRID_POINTS_VIRT_X - 1][ABL_GRID_POINTS_VIRT_Y - 1];
+    #else
+      static mesh_cell_t cells[GRID_MAX_CELLS_X][GRID_MAX_CELLS_Y];
+    #endif
+    static void refresh_cells();
+  #endif
+
 public:
   static void reset();
   static void set_grid(const xy_pos_t& _grid_spacing, const xy_pos_t& _grid_start);
@@ -75,6 +75,9 @@ void set_bed_leveling_enabled(const bool enable/*=true*/) {
     _report_leveling();
     planner.synchronize();
 
+    // The mesh may have been edited while leveling was off
+    TERN_(AUTO_BED_LEVELING_UBL, if (enable) bedlevel.refresh_bed_level());
+
     // Get the corrected leveled / unleveled position
     planner.apply_modifiers(current_position, true);    // Physical position with all modifiers
     planner.leveling_active ^= true;                    // Toggle leveling between apply and unapply
@@ -61,6 +61,22 @@ class TemporaryBedLevelingState {
 
   typedef float bed_mesh_t[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 
+  #if ENABLED(MESH_CELL_CACHE)
+    /**
+     * One mesh cell as a bilinear surface z = z0 + dx * u + dy * v + dxy * u * v
+     * where u, v are the position in the cell in units of the grid spacing.
+     * An undefined (NAN) corner makes the whole cell NAN, so UBL passes 0 instead
+     * and flags the cell.
+     */
+    struct mesh_cell_t {
+      float z0, dx, dy, dxy;
+      void set(const_float_t z00, const_float_t z10, const_float_t z01, const_float_t z11) {
+        z0 = z00; dx = z10 - z00; dy = z01 - z00; dxy = z11 - z10 - dy;
+      }
+      float z(const xy_float_t &uv) const { return z0 + dx * uv.x + (dy + dxy * uv.x) * uv.y; }
+    };
+  #endif
+
   #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
     #include "abl/bbl.h"
   #elif ENABLED(AUTO_BED_LEVELING_UBL)
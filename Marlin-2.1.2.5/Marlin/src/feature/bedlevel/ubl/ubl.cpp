@@ -67,6 +67,8 @@ int8_t unified_bed_leveling::storage_slot;
 
 float unified_bed_leveling::z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 
+#if UBL_MESH_POS_TABLES
+
 #define _GRIDPOS(A,N) (MESH_MIN_##A + N * (MESH_##A##_DIST))
 
 const float
@@ -83,6 +85,8 @@ unified_bed_leveling::_mesh_index_to_ypos[GRID_MAX_POINTS_Y] PROGMEM = ARRAY_N(G
   _GRIDPOS(Y, 12), _GRIDPOS(Y, 13), _GRIDPOS(Y, 14), _GRIDPOS(Y, 15)
 );
 
+#endif // UBL_MESH_POS_TABLES
+
 volatile int16_t unified_bed_leveling::encoder_diff;
 
 unified_bed_leveling::unified_bed_leveling() { reset(); }
@@ -92,6 +96,7 @@ void unified_bed_leveling::reset() {
   set_bed_leveling_enabled(false);
   storage_slot = -1;
   ZERO(z_values);
+  refresh_bed_level();
   #if ENABLED(EXTENSIBLE_UI)
     GRID_LOOP(x, y) ExtUI::onMeshUpdate(x, y, 0);
   #endif
@@ -108,31 +113,143 @@ void unified_bed_leveling::set_all_mesh_points_to_value(const_float_t value) {
     z_values[x][y] = value;
     TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, value));
   }
+  refresh_bed_level();
 }
 
+#if ENABLED(MESH_CELL_CACHE)
+
+  mesh_cell_t unified_bed_leveling::cells[GRID_MAX_CELLS_X][GRID_MAX_CELLS_Y];
+  FlagBits<GRID_MAX_CELLS_X, GRID_MAX_CELLS_Y> unified_bed_leveling::partial_cells;
+  bool unified_bed_leveling::cells_valid; // = false
+
+  // Precompute the bilinear coefficients of every mesh cell.
+  // Undefined points count as 0, as segmented moves have always done,
+  // so a partly probed cell still interpolates from its valid corners.
+  // Such cells are flagged so get_z_correction can still leave them out.
+  void unified_bed_leveling::refresh_cells() {
+    partial_cells.reset();
+    for (uint8_t x = 0; x < GRID_MAX_CELLS_X; ++x)
+      for (uint8_t y = 0; y < GRID_MAX_CELLS_Y; ++y) {
+        float z[4] = { z_values[x][y], z_values[x + 1][y], z_values[x][y + 1], z_values[x + 1][y + 1] };
+        for (uint8_t i = 0; i < 4; ++i) if (isnan(z[i])) { z[i] = 0; partial_cells.mark(x, y); }
+        cells[x][y].set(z[0], z[1], z[2], z[3]);
+      }
+    cells_valid = true;
+  }
+
+  /**
+   * Add the mesh Z correction, times 'scale', to a batch of positions,
+   * usually the segment ends of one move. Unlike get_z_correction there is
+   * no UBL_Z_RAISE_WHEN_OFF_MESH.
+   */
+  void unified_bed_leveling::apply_z_correction(xyze_pos_t pos[], const uint8_t count, const_float_t scale/*=1.0f*/) {
+    for (uint8_t i = 0; i < count; ++i)
+      pos[i].z += get_cell_z(pos[i].x, pos[i].y) * scale;
+  }
+
+#endif // MESH_CELL_CACHE
+
 #if ENABLED(OPTIMIZED_MESH_STORAGE)
 
   constexpr float mesh_store_scaling = 1000;
   constexpr int16_t Z_STEPS_NAN = INT16_MAX;
 
+  static int16_t z_to_store(const_float_t z) {
+    if (isnan(z)) return Z_STEPS_NAN;
+    const int32_t z_scaled = TRUNC(z * mesh_store_scaling);
+    if (z_scaled == Z_STEPS_NAN || !WITHIN(z_scaled, INT16_MIN, INT16_MAX))
+      return Z_STEPS_NAN; // If Z is out of range, return our custom 'NaN'
+    return int16_t(z_scaled);
+  }
+
+  static float store_to_z(const int16_t z_scaled) {
+    return z_scaled == Z_STEPS_NAN ? NAN : z_scaled / mesh_store_scaling;
+  }
+
   void unified_bed_leveling::set_store_from_mesh(const bed_mesh_t &in_values, mesh_store_t &stored_values) {
-    auto z_to_store = [](const_float_t z) {
-      if (isnan(z)) return Z_STEPS_NAN;
-      const int32_t z_scaled = TRUNC(z * mesh_store_scaling);
-      if (z_scaled == Z_STEPS_NAN || !WITHIN(z_scaled, INT16_MIN, INT16_MAX))
-        return Z_STEPS_NAN; // If Z is out of range, return our custom 'NaN'
-      return int16_t(z_scaled);
-    };
     GRID_LOOP(x, y) stored_values[x][y] = z_to_store(in_values[x][y]);
   }
 
   void unified_bed_leveling::set_mesh_from_store(const mesh_store_t &stored_values, bed_mesh_t &out_values) {
-    auto store_to_z = [](const int16_t z_scaled) {
-      return z_scaled == Z_STEPS_NAN ? NAN : z_scaled / mesh_store_scaling;
-    };
     GRID_LOOP(x, y) out_values[x][y] = store_to_z(stored_values[x][y]);
   }
 
+  #if ENABLED(COMPRESSED_MESH_STORAGE)
+
+    /**
+     * Predict a stored point from its already-coded neighbors.
+     * A plane through the three neighbors when they are all valid,
+     * otherwise the nearest valid neighbor, otherwise zero.
+     */
+    static int32_t predict_store(const int16_t *prev, const int16_t *cur, const uint8_t y) {
+      const int16_t b = prev ? prev[y] : Z_STEPS_NAN;
+      if (y == 0) return b == Z_STEPS_NAN ? 0 : b;
+      const int16_t a = cur[y - 1], c = prev ? prev[y - 1] : Z_STEPS_NAN;
+      if (a != Z_STEPS_NAN && b != Z_STEPS_NAN && c != Z_STEPS_NAN) return int32_t(a) + b - c;
+      if (a != Z_STEPS_NAN) return a;
+      return b == Z_STEPS_NAN ? 0 : b;
+    }
+
+    /**
+     * Encode the mesh, in microns, as the zigzag varint of each point's
+     * difference from its prediction. Code 0 marks an invalid point.
+     * A smooth mesh packs to about one byte per point.
+     * Return the packed size, or 0 if it doesn't fit in maxlen bytes.
+     */
+    uint16_t unified_bed_leveling::pack_mesh(const bed_mesh_t &in_values, uint8_t * const out, const uint16_t maxlen) {
+      int16_t rows[2][GRID_MAX_POINTS_Y];
+      uint16_t len = 0;
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X; ++x) {
+        int16_t * const cur = rows[x & 1], * const prev = x ? rows[~x & 1] : nullptr;
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; ++y) {
+          const int16_t z = cur[y] = z_to_store(in_values[x][y]);
+          uint32_t code = 0;
+          if (z != Z_STEPS_NAN) {
+            const int32_t d = z - predict_store(prev, cur, y);
+            code = ((uint32_t(d) << 1) ^ uint32_t(d >> 31)) + 1;
+          }
+          do {
+            if (len >= maxlen) return 0;
+            out[len++] = (code & 0x7F) | (code > 0x7F ? 0x80 : 0);
+            code >>= 7;
+          } while (code);
+        }
+      }
+      return len;
+    }
+
+    /**
+     * Decode a packed mesh. Return false if the data is corrupt,
+     * leaving out_values partially filled.
+     */
+    bool unified_bed_leveling::unpack_mesh(const uint8_t * const in, const uint16_t len, bed_mesh_t &out_values) {
+      int16_t rows[2][GRID_MAX_POINTS_Y];
+      uint16_t i = 0;
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X; ++x) {
+        int16_t * const cur = rows[x & 1], * const prev = x ? rows[~x & 1] : nullptr;
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; ++y) {
+          uint32_t code = 0;
+          for (uint8_t shift = 0; ; shift += 7) {
+            if (i >= len || shift > 21) return false;
+            const uint8_t b = in[i++];
+            code |= uint32_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+          }
+          int16_t z = Z_STEPS_NAN;
+          if (code) {
+            --code;
+            const int32_t zz = predict_store(prev, cur, y) + (int32_t(code >> 1) ^ -int32_t(code & 1));
+            if (zz == Z_STEPS_NAN || !WITHIN(zz, INT16_MIN, INT16_MAX)) return false;
+            z = int16_t(zz);
+          }
+          out_values[x][y] = store_to_z(cur[y] = z);
+        }
+      }
+      return i == len;
+    }
+
+  #endif // COMPRESSED_MESH_STORAGE
+
 #endif // OPTIMIZED_MESH_STORAGE
 
 static void serial_echo_xy(const uint8_t sp, const int16_t x, const int16_t y) {
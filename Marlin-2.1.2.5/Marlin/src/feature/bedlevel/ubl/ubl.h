@@ -41,6 +41,11 @@ struct mesh_index_pair;
 #define MESH_X_DIST (float((MESH_MAX_X) - (MESH_MIN_X)) / (GRID_MAX_CELLS_X))
 #define MESH_Y_DIST (float((MESH_MAX_Y) - (MESH_MIN_Y)) / (GRID_MAX_CELLS_Y))
 
+// Position lookup tables are only generated for grids up to 16x16
+#if GRID_MAX_POINTS_X <= 16 && GRID_MAX_POINTS_Y <= 16
+  #define UBL_MESH_POS_TABLES 1
+#endif
+
 #if ENABLED(OPTIMIZED_MESH_STORAGE)
   typedef int16_t mesh_store_t[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 #endif
@@ -83,6 +88,13 @@ private:
     return smart_fill_one(pos.x, pos.y, dir.x, dir.y);
   }
 
+  #if ENABLED(MESH_CELL_CACHE)
+    static mesh_cell_t cells[GRID_MAX_CELLS_X][GRID_MAX_CELLS_Y];
+    static FlagBits<GRID_MAX_CELLS_X, GRID_MAX_CELLS_Y> partial_cells; // Cells with an undefined corner
+    static bool cells_valid;
+    static void refresh_cells();
+  #endif
+
   #if ENABLED(UBL_DEVEL_DEBUGGING)
     static void g29_what_command();
     static void g29_eeprom_dump();
@@ -116,8 +128,15 @@ public:
     static void set_store_from_mesh(const bed_mesh_t &in_values, mesh_store_t &stored_values);
     static void set_mesh_from_store(const mesh_store_t &stored_values, bed_mesh_t &out_values);
   #endif
-  static const float _mesh_index_to_xpos[GRID_MAX_POINTS_X],
-                     _mesh_index_to_ypos[GRID_MAX_POINTS_Y];
+  #if ENABLED(COMPRESSED_MESH_STORAGE)
+    static uint16_t pack_mesh(const bed_mesh_t &in_values, uint8_t * const out, const uint16_t maxlen);
+    static bool unpack_mesh(const uint8_t * const in, const uint16_t len, bed_mesh_t &out_values);
+  #endif
+
+  #if UBL_MESH_POS_TABLES
+    static const float _mesh_index_to_xpos[GRID_MAX_POINTS_X],
+                       _mesh_index_to_ypos[GRID_MAX_POINTS_Y];
+  #endif
 
   #if HAS_MARLINUI_MENU
     static bool lcd_map_control;
@@ -130,7 +149,14 @@ public:
 
   unified_bed_leveling();
 
-  FORCE_INLINE static void set_z(const int8_t px, const int8_t py, const_float_t z) { z_values[px][py] = z; }
+  FORCE_INLINE static void set_z(const int8_t px, const int8_t py, const_float_t z) { z_values[px][py] = z; refresh_bed_level(); }
+
+  // Call after changing z_values directly
+  #if ENABLED(MESH_CELL_CACHE)
+    static void refresh_bed_level() { cells_valid = false; }
+  #else
+    static void refresh_bed_level() {}
+  #endif
 
   static int8_t cell_index_x_raw(const_float_t x) {
     return FLOOR((x - (MESH_MIN_X)) * RECIPROCAL(MESH_X_DIST));
@@ -245,6 +271,26 @@ public:
                                                                                         // z_values[][] array and no correction is applied.
   }
 
+  #if ENABLED(MESH_CELL_CACHE)
+    /**
+     * Bilinear Z from the cached cell coefficients. Outside the mesh the
+     * nearest edge cell is extrapolated, the same as get_z_correction.
+     * With 'nan_if_partial' a cell with an undefined corner gives NAN,
+     * as z_values[][] would, instead of interpolating from 0.
+     */
+    static float get_cell_z(const_float_t rx0, const_float_t ry0, const bool nan_if_partial=false) {
+      if (!cells_valid) refresh_cells();
+      // Position in grid units. The whole part picks the cell, the fraction is the position in it.
+      xy_float_t ratio = { (rx0 - (MESH_MIN_X)) * RECIPROCAL(MESH_X_DIST), (ry0 - (MESH_MIN_Y)) * RECIPROCAL(MESH_Y_DIST) };
+      const int8_t cx = constrain(FLOOR(ratio.x), 0, GRID_MAX_CELLS_X - 1),
+                   cy = constrain(FLOOR(ratio.y), 0, GRID_MAX_CELLS_Y - 1);
+      ratio.x -= cx;
+      ratio.y -= cy;
+      if (nan_if_partial && partial_cells.marked(cx, cy)) return NAN;
+      return cells[cx][cy].z(ratio);
+    }
+  #endif
+
   /**
    * This is the generic Z-Correction. It works anywhere within a Mesh Cell. It first
    * does a linear interpolation along both of the bounding X-Mesh-Lines to find the
@@ -252,8 +298,6 @@ public:
    * on the Y position within the cell.
    */
   static float get_z_correction(const_float_t rx0, const_float_t ry0) {
-    const int8_t cx = cell_index_x(rx0), cy = cell_index_y(ry0); // return values are clamped
-
     /**
      * Check if the requested location is off the mesh.  If so, and
      * UBL_Z_RAISE_WHEN_OFF_MESH is specified, that value is returned.
@@ -263,11 +307,16 @@ public:
         return UBL_Z_RAISE_WHEN_OFF_MESH;
     #endif
 
-    const uint8_t mx = _MIN(cx, (GRID_MAX_POINTS_X) - 2) + 1, my = _MIN(cy, (GRID_MAX_POINTS_Y) - 2) + 1;
-    const float x0 = get_mesh_x(cx), x1 = get_mesh_x(cx + 1),
-                z1 = calc_z0(rx0, x0, z_values[cx][cy], x1, z_values[mx][cy]),
-                z2 = calc_z0(rx0, x0, z_values[cx][my], x1, z_values[mx][my]);
-    float z0 = calc_z0(ry0, get_mesh_y(cy), z1, get_mesh_y(cy + 1), z2);
+    #if ENABLED(MESH_CELL_CACHE)
+      float z0 = get_cell_z(rx0, ry0, true);
+    #else
+      const int8_t cx = cell_index_x(rx0), cy = cell_index_y(ry0); // return values are clamped
+      const uint8_t mx = _MIN(cx, (GRID_MAX_POINTS_X) - 2) + 1, my = _MIN(cy, (GRID_MAX_POINTS_Y) - 2) + 1;
+      const float x0 = get_mesh_x(cx), x1 = get_mesh_x(cx + 1),
+                  z1 = calc_z0(rx0, x0, z_values[cx][cy], x1, z_values[mx][cy]),
+                  z2 = calc_z0(rx0, x0, z_values[cx][my], x1, z_values[mx][my]);
+      float z0 = calc_z0(ry0, get_mesh_y(cy), z1, get_mesh_y(cy + 1), z2);
+    #endif
 
     if (isnan(z0)) { // If part of the Mesh is undefined, it will show up as NAN
       z0 = 0.0;      // in z_values[][] and propagate through the calculations.
@@ -287,14 +336,23 @@ public:
   }
   static float get_z_correction(const xy_pos_t &pos) { return get_z_correction(pos.x, pos.y); }
 
+  #if ENABLED(MESH_CELL_CACHE)
+    static void apply_z_correction(xyze_pos_t pos[], const uint8_t count, const_float_t scale=1.0f);
+  #endif
+
   static constexpr float get_z_offset() { return 0.0f; }
 
-  static float get_mesh_x(const uint8_t i) {
-    return i < (GRID_MAX_POINTS_X) ? pgm_read_float(&_mesh_index_to_xpos[i]) : MESH_MIN_X + i * (MESH_X_DIST);
-  }
-  static float get_mesh_y(const uint8_t i) {
-    return i < (GRID_MAX_POINTS_Y) ? pgm_read_float(&_mesh_index_to_ypos[i]) : MESH_MIN_Y + i * (MESH_Y_DIST);
-  }
+  #if UBL_MESH_POS_TABLES
+    static float get_mesh_x(const uint8_t i) {
+      return i < (GRID_MAX_POINTS_X) ? pgm_read_float(&_mesh_index_to_xpos[i]) : MESH_MIN_X + i * (MESH_X_DIST);
+    }
+    static float get_mesh_y(const uint8_t i) {
+      return i < (GRID_MAX_POINTS_Y) ? pgm_read_float(&_mesh_index_to_ypos[i]) : MESH_MIN_Y + i * (MESH_Y_DIST);
+    }
+  #else
+    static float get_mesh_x(const uint8_t i) { return MESH_MIN_X + i * (MESH_X_DIST); }
+    static float get_mesh_y(const uint8_t i) { return MESH_MIN_Y + i * (MESH_Y_DIST); }
+  #endif
 
   #if UBL_SEGMENTED
     static bool line_to_destination_segmented(const_feedRate_t scaled_fr_mm_s);
@@ -1716,15 +1716,14 @@ void unified_bed_leveling::smart_fill_mesh() {
     // being extrapolated so that nearby points will have greater influence on
     // the point being extrapolated.  Then extrapolate the mesh point from WLSF.
 
-    static_assert((GRID_MAX_POINTS_Y) <= 16, "GRID_MAX_POINTS_Y too big");
-    uint16_t bitmap[GRID_MAX_POINTS_X] = { 0 };
+    MeshFlags valid_flags{0};
     struct linear_fit_data lsf_results;
 
     SERIAL_ECHOPGM("Extrapolating mesh...");
 
     const float weight_scaled = weight_factor * _MAX(MESH_X_DIST, MESH_Y_DIST);
 
-    GRID_LOOP(jx, jy) if (!isnan(z_values[jx][jy])) SBI(bitmap[jx], jy);
+    GRID_LOOP(jx, jy) if (!isnan(z_values[jx][jy])) valid_flags.mark(jx, jy);
 
     xy_pos_t ppos;
     for (uint8_t ix = 0; ix < GRID_MAX_POINTS_X; ++ix) {
@@ -1738,7 +1737,7 @@ void unified_bed_leveling::smart_fill_mesh() {
           for (uint8_t jx = 0; jx < GRID_MAX_POINTS_X; ++jx) {
             rpos.x = get_mesh_x(jx);
             for (uint8_t jy = 0; jy < GRID_MAX_POINTS_Y; ++jy) {
-              if (TEST(bitmap[jx], jy)) {
+              if (valid_flags.marked(jx, jy)) {
                 rpos.y = get_mesh_y(jy);
                 const float rz = z_values[jx][jy],
                              w = 1.0f + weight_scaled / (rpos - ppos).magnitude();
@@ -1831,7 +1830,7 @@ void unified_bed_leveling::smart_fill_mesh() {
     SERIAL_ECHOLNPGM("EEPROM free for UBL: ", hex_address((void*)(settings.meshes_end_index() - settings.meshes_start_index())));
     serial_delay(50);
 
-    SERIAL_ECHOLNPGM("EEPROM can hold ", settings.calc_num_meshes(), " meshes.\n");
+    SERIAL_ECHOLNPGM(TERN(MESH_STORE_SDCARD, "Media", "EEPROM"), " can hold ", settings.calc_num_meshes(), " meshes.\n");
     serial_delay(25);
 
     if (!sanity_check()) {
@@ -402,6 +402,24 @@
       const float fade_scaling_factor = planner.fade_scaling_factor_for_z(destination.z);
     #endif
 
+    #if ENABLED(MESH_CELL_CACHE)
+
+      // Level the segment ends a batch at a time with the cached cell coefficients
+      xyze_pos_t batch[8];
+      while (segments) {
+        const uint8_t count = _MIN(segments, COUNT(batch));
+        for (uint8_t i = 0; i < count; ++i) { raw += diff; batch[i] = raw; }
+        segments -= count;
+        if (!segments) batch[count - 1] = destination;  // Use destination for the exact end
+
+        apply_z_correction(batch, count, TERN(ENABLE_LEVELING_FADE_HEIGHT, fade_scaling_factor, 1.0f));
+
+        for (uint8_t i = 0; i < count; ++i)
+          planner.buffer_line(batch[i], scaled_fr_mm_s, active_extruder, hints);
+      }
+
+    #else
+
     // Move to first segment destination
     raw += diff;
 
@@ -484,6 +502,8 @@
       } // segment loop
     } // cell loop
 
+    #endif // !MESH_CELL_CACHE
+
     return false; // caller will update current_position
   }
 
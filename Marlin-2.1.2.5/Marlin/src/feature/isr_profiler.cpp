@@ -0,0 +1,184 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+
+#include "isr_profiler.h"
+#include "../module/stepper.h"
+
+#if ISR_PROFILE_HOST
+  #include <chrono>
+#endif
+
+ISRProfiler isr_profiler;
+
+ISRProfiler::histogram_t ISRProfiler::hist[NUM_PHASES];
+uint32_t ISRProfiler::overhead; // = 0
+#if ISR_PROFILE_DWT
+  bool ISRProfiler::has_dwt; // = false
+#endif
+#if ENABLED(CALIBRATE_MULTISTEPPING)
+  uint16_t ISRProfiler::isr_steps; // = 0
+  uint8_t ISRProfiler::isr_multistep;
+  uint32_t ISRProfiler::level_isrs[8];
+  uint64_t ISRProfiler::level_cycles[8];
+#endif
+
+#if ISR_PROFILE_HOST
+  // Host time in cycles of the simulated CPU
+  uint32_t ISRProfiler::host_cycles() {
+    const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return uint32_t(ns * ((F_CPU) / 1000000UL) / 1000UL);
+  }
+#endif
+
+void ISRProfiler::reset() {
+  // calibrate_delay_loop() starts the cycle counter on cores that have one
+  TERN_(ISR_PROFILE_DWT, has_dwt = (*(volatile uint32_t *)0xE0001000) & 1); // DWT_CTRL.CYCCNTENA
+
+  const bool awake = stepper.suspend();
+  ZERO(hist);
+  #if ENABLED(CALIBRATE_MULTISTEPPING)
+    ZERO(level_isrs);
+    ZERO(level_cycles);
+  #endif
+
+  // The least time measured for nothing at all
+  overhead = 0;
+  uint32_t least = UINT32_MAX;
+  for (uint8_t i = 0; i < 8; ++i) {
+    const uint32_t start = now();
+    NOMORE(least, elapsed(start));
+  }
+  overhead = least;
+
+  if (awake) stepper.wake_up();
+}
+
+void ISRProfiler::snapshot(const Phase p, histogram_t &h) {
+  const bool awake = stepper.suspend();
+  h = hist[p];
+  if (awake) stepper.wake_up();
+}
+
+#if ENABLED(CALIBRATE_MULTISTEPPING)
+
+  /**
+   * Fit cycles = base + per_step * steps to the mean ISR time measured at
+   * each multistep level, then allow each level the ISR rate that leaves
+   * MULTISTEPPING_MARGIN of headroom. Levels that were never used get
+   * their limits from the fit. With only one level measured, the cost per
+   * step comes from the estimate in stepper.h.
+   */
+  bool ISRProfiler::calibrate_multistepping() {
+    uint32_t isrs[8];
+    uint64_t cycles[8];
+    const bool awake = stepper.suspend();
+    COPY(isrs, level_isrs);
+    COPY(cycles, level_cycles);
+    if (awake) stepper.wake_up();
+
+    float n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (uint8_t i = 0; i < 8; ++i) {
+      if (isrs[i] < 100) continue;
+      const float x = 1 << i, y = float(cycles[i]) / isrs[i];
+      n++; sx += x; sy += y; sxx += sq(x); sxy += x * y;
+    }
+    if (!n) return false;
+
+    const float d = n * sxx - sq(sx);
+    float per_step = (n > 1 && d > 0) ? (n * sxy - sx * sy) / d
+                   : float(ISR_LOOP_BASE_CYCLES + MIN_ISR_LOOP_CYCLES + MIN_STEPPER_PULSE_CYCLES);
+    NOLESS(per_step, 1.0f);
+    const float base = _MAX((sy - per_step * sx) / n, 0.0f);
+
+    uint32_t limits[8];
+    for (uint8_t i = 0; i < 8; ++i) {
+      const float isr_cycles = (base + per_step * (1 << i)) * (100 + (MULTISTEPPING_MARGIN)) / 100.0f;
+      uint32_t rate = (F_CPU) / isr_cycles;
+      NOMORE(rate, uint32_t(MAXIMUM_STEPPER_RATE) >> i);        // The drivers' limit
+      TERN_(__AVR__, NOMORE(rate, 0xFFFFUL - (F_CPU) / 500000U)); // The range of the speed tables
+      limits[i] = _MAX(rate, 1UL);
+    }
+    stepper.set_multistep_limits(limits);
+    return true;
+  }
+
+#endif // CALIBRATE_MULTISTEPPING
+
+// Floor of the bucket holding the given percentile
+static uint32_t percentile(const ISRProfiler::histogram_t &h, const uint8_t pct) {
+  const uint32_t rank = (uint64_t(h.samples) * pct + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < ISRProfiler::BUCKETS; ++i)
+    if ((seen += h.count[i]) >= rank && seen) return ISRProfiler::bucket_floor(i);
+  return h.max;
+}
+
+static FSTR_P phase_name(const ISRProfiler::Phase p) {
+  switch (p) {
+    default:
+    case ISRProfiler::PHASE_ISR:      return F("isr");
+    case ISRProfiler::PHASE_PULSE:    return F("pulse");
+    case ISRProfiler::PHASE_BLOCK:    return F("block");
+    case ISRProfiler::PHASE_ADVANCE:  return F("advance");
+    case ISRProfiler::PHASE_SHAPING:  return F("shaping");
+    case ISRProfiler::PHASE_BABYSTEP: return F("babystep");
+  }
+}
+
+void ISRProfiler::report(const bool verbose) {
+  SERIAL_ECHOLNPGM("Stepper ISR cycles at ", uint32_t((F_CPU) / 1000000UL), "MHz, timing overhead ", overhead);
+
+  histogram_t h;
+  uint32_t isr_p99 = 0;
+  for (uint8_t p = 0; p < NUM_PHASES; ++p) {
+    snapshot(Phase(p), h);
+    if (!h.samples) continue;
+    const uint32_t p99 = percentile(h, 99);
+    if (p == PHASE_ISR) isr_p99 = p99;
+    SERIAL_ECHOPGM("  ");
+    SERIAL_ECHOF(phase_name(Phase(p)));
+    SERIAL_ECHOLNPGM(": ", h.samples, " calls, mean ", uint32_t(h.total / h.samples),
+      " p50:", percentile(h, 50), " p90:", percentile(h, 90), " p99:", p99, " max:", h.max);
+    if (verbose) for (uint8_t i = 0; i < BUCKETS; ++i)
+      if (h.count[i]) SERIAL_ECHOLNPGM("    >=", bucket_floor(i), ": ", h.count[i]);
+  }
+
+  // Compare with the estimate that sets the step rate limits
+  SERIAL_ECHOLNPGM("Estimated ISR cycles per step: ", uint32_t(ISR_EXECUTION_CYCLES(1)), ", max rate ", uint32_t(MAX_STEP_ISR_FREQUENCY_1X), "Hz");
+  if (isr_p99) SERIAL_ECHOLNPGM("Measured ISR cycles p99: ", isr_p99, ", max rate ", uint32_t((F_CPU) / isr_p99), "Hz");
+
+  #if ENABLED(CALIBRATE_MULTISTEPPING)
+    SERIAL_ECHOPGM("Mean ISR cycles at");
+    for (uint8_t i = 0; i < 8; ++i)
+      if (level_isrs[i]) SERIAL_ECHOPGM(" ", 1 << i, "x:", uint32_t(level_cycles[i] / level_isrs[i]));
+    SERIAL_EOL();
+    SERIAL_ECHOPGM("Multistepping ISR limits (Hz)");
+    for (uint8_t i = 0; i < 8; ++i) SERIAL_ECHOPGM(" ", 1 << i, "x:", stepper.multistep_limit[i]);
+    SERIAL_EOL();
+  #endif
+}
+
+#endif // STEPPER_ISR_PROFILE
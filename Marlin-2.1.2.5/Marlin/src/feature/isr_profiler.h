@@ -0,0 +1,170 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/isr_profiler.h - Measure the cycles taken by the stepper ISR
+ *
+ * Each phase of Stepper::isr() is timed and the times go into histograms
+ * with two buckets per power of 2, so percentiles can be read without
+ * keeping every sample. Report them with M881.
+ *
+ * Time is counted in CPU cycles: with the DWT cycle counter on ARM cores
+ * that have one, host time scaled to F_CPU on the native target, or else
+ * the step timer scaled to F_CPU. Interrupts are enabled during the phases,
+ * so other interrupts may show up in the tail of the histograms.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if defined(__PLAT_LINUX__) || defined(__PLAT_NATIVE_SIM__)
+  #define ISR_PROFILE_HOST 1
+#elif defined(__arm__) || defined(__thumb__)
+  #define ISR_PROFILE_DWT 1
+#endif
+
+class ISRProfiler {
+public:
+  enum Phase : uint8_t {
+    PHASE_ISR,        // The whole Stepper::isr(), all phases included
+    PHASE_PULSE,      // pulse_phase_isr
+    PHASE_BLOCK,      // block_phase_isr
+    PHASE_ADVANCE,    // advance_isr
+    PHASE_SHAPING,    // shaping_isr
+    PHASE_BABYSTEP,   // babystepping_isr
+    NUM_PHASES
+  };
+
+  static constexpr uint8_t BUCKETS = 32;    // Up to 65535 cycles, then the last bucket
+
+  typedef struct {
+    uint32_t count[BUCKETS];
+    uint32_t samples, max;
+    uint64_t total;
+  } histogram_t;
+
+  static histogram_t hist[NUM_PHASES];
+
+  // The current time, in cycles or step timer ticks
+  static uint32_t now() {
+    #if ISR_PROFILE_HOST
+      return host_cycles();
+    #else
+      #if ISR_PROFILE_DWT
+        if (has_dwt) return *(volatile uint32_t *)0xE0001004; // DWT_CYCCNT
+      #endif
+      return HAL_timer_get_count(MF_TIMER_STEP);
+    #endif
+  }
+
+  // Cycles since 'start', a value from now()
+  static uint32_t elapsed(const uint32_t start) {
+    #if ISR_PROFILE_HOST
+      return host_cycles() - start;
+    #else
+      #if ISR_PROFILE_DWT
+        if (has_dwt) return now() - start;
+      #endif
+      return hal_timer_t(HAL_timer_get_count(MF_TIMER_STEP) - hal_timer_t(start)) * ((F_CPU) / (STEPPER_TIMER_RATE));
+    #endif
+  }
+
+  // Add the time since 'start' to the phase histogram
+  static void add(const Phase p, const uint32_t start) {
+    const uint32_t t = elapsed(start);
+    record(p, t > overhead ? t - overhead : 0);
+  }
+
+  // Add the time since 'start' to the whole ISR histogram
+  static void add_isr(const uint32_t start) {
+    const uint32_t t = elapsed(start), cycles = t > overhead ? t - overhead : 0;
+    record(PHASE_ISR, cycles);
+    #if ENABLED(CALIBRATE_MULTISTEPPING)
+      // Only ISRs that took the full multistep count tell the cost of each level
+      if (isr_steps && isr_steps == isr_multistep) {
+        const uint8_t level = __builtin_ctz(isr_multistep);
+        level_isrs[level]++;
+        level_cycles[level] += cycles;
+      }
+      isr_steps = 0;
+    #endif
+  }
+
+  #if ENABLED(CALIBRATE_MULTISTEPPING)
+    // Count the steps taken by the pulse phase
+    static void steps_done(const uint8_t steps, const uint8_t multistep) {
+      isr_steps += steps;
+      isr_multistep = multistep;
+    }
+
+    // Set the multistepping limits from the measured ISR times. False if too few were measured.
+    static bool calibrate_multistepping();
+  #endif
+
+  static uint8_t bucket(const uint32_t cycles) {
+    if (cycles < 4) return cycles;
+    const uint8_t octave = 8 * sizeof(long) - 1 - __builtin_clzl(cycles); // 'long' is at least 32 bits, even on AVR
+    const uint8_t i = 4 + (octave - 2) * 2 + ((cycles >> (octave - 1)) & 1);
+    return _MIN(i, BUCKETS - 1);
+  }
+
+  // The fewest cycles counted in a bucket
+  static uint32_t bucket_floor(const uint8_t i) {
+    if (i < 4) return i;
+    return uint32_t(2 + ((i - 4) & 1)) << ((i - 4) / 2 + 1);
+  }
+
+  // Clear the histograms and measure the cost of timing
+  static void reset();
+
+  // Copy one histogram with the stepper ISR held off
+  static void snapshot(const Phase p, histogram_t &h);
+
+  static void report(const bool verbose);
+
+private:
+  static uint32_t overhead;     // Cycles taken by now() and elapsed() themselves
+  #if ISR_PROFILE_DWT
+    static bool has_dwt;
+  #endif
+  #if ISR_PROFILE_HOST
+    static uint32_t host_cycles();
+  #endif
+  #if ENABLED(CALIBRATE_MULTISTEPPING)
+    static uint16_t isr_steps;          // Steps taken so far in this ISR
+    static uint8_t isr_multistep;       // Steps per ISR at the last pulse phase
+    static uint32_t level_isrs[8];      // Full ISRs measured at 1x to 128x
+    static uint64_t level_cycles[8];    // and their total cycles
+  #endif
+
+  static void record(const Phase p, const uint32_t cycles) {
+    histogram_t &h = hist[p];
+    h.count[bucket(cycles)]++;
+    h.samples++;
+    h.total += cycles;
+    NOLESS(h.max, cycles);
+  }
+};
+
+extern ISRProfiler isr_profiler;
+
+#define ISR_PROFILE(P, CODE) do{ const uint32_t _isr_prof_start = ISRProfiler::now(); CODE; ISRProfiler::add(ISRProfiler::PHASE_##P, _isr_prof_start); }while(0)
@@ -0,0 +1,114 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+
+#include "move_merge.h"
+
+#include "../module/motion.h"
+#include "../module/planner.h"
+
+MoveMerge move_merge;
+
+uint8_t MoveMerge::count; // = 0
+uint8_t MoveMerge::extruder;
+feedRate_t MoveMerge::fr_mm_s;
+float MoveMerge::length, MoveMerge::e_per_mm;
+xyz_pos_t MoveMerge::start;
+xyze_pos_t MoveMerge::end;
+xyz_pos_t MoveMerge::vertex[(MERGE_MOVES_MAX_COUNT) - 1];
+
+static float dot(const xyz_pos_t &a, const xyz_pos_t &b) {
+  float s = 0;
+  LOOP_NUM_AXES(i) s += a[i] * b[i];
+  return s;
+}
+
+/**
+ * Check whether the held move can be extended to 'target'.
+ * The joined line runs from 'start' to 'target'. Every vertex it replaces,
+ * including the current 'end', must lie within tolerance of that line and
+ * in order along it, so the path never doubles back.
+ */
+bool MoveMerge::can_join(const xyze_pos_t &target, const float seg_len, const float seg_e_per_mm) {
+  if (count >= (MERGE_MOVES_MAX_COUNT) || extruder != active_extruder) return false;
+
+  // Extrusion per mm must agree, which also keeps travel and extrusion apart
+  if (ABS(seg_e_per_mm - e_per_mm) > (MERGE_MOVES_E_RATIO) * _MAX(ABS(seg_e_per_mm), ABS(e_per_mm)))
+    return false;
+
+  const xyz_pos_t chord = xyz_pos_t(target) - start;
+  const float chord_sqr = dot(chord, chord);
+
+  constexpr float tol_sqr = sq(float(MERGE_MOVES_TOLERANCE));
+  float last_t = 0;
+  for (uint8_t n = 0; n < count; ++n) {
+    const xyz_pos_t v = (n < count - 1 ? vertex[n] : xyz_pos_t(end)) - start;
+    const float t = dot(v, chord); // Projection onto the chord, scaled by |chord|
+    if (t <= last_t || t >= chord_sqr) return false;
+    if (dot(v, v) - sq(t) / chord_sqr > tol_sqr) return false;
+    last_t = t;
+  }
+  return true;
+}
+
+void MoveMerge::line_to(const xyze_pos_t &from, const xyze_pos_t &target, const_feedRate_t fr) {
+  const float seg_len = (xyz_pos_t(target) - xyz_pos_t(from)).magnitude(),
+              seg_e_per_mm = seg_len ? TERN0(HAS_EXTRUDERS, (target.e - from.e) / seg_len) : 0;
+
+  // Only short moves with some linear motion are worth holding
+  const bool mergeable = seg_len > 0 && seg_len < (MERGE_MOVES_MAX_LENGTH);
+
+  if (count) {
+    if (mergeable && fr == fr_mm_s && can_join(target, seg_len, seg_e_per_mm)) {
+      vertex[count - 1] = end;
+      end = target;
+      e_per_mm = (e_per_mm * length + seg_e_per_mm * seg_len) / (length + seg_len);
+      length += seg_len;
+      count++;
+      return;
+    }
+    flush();
+  }
+
+  if (mergeable) {
+    count = 1;
+    extruder = active_extruder;
+    fr_mm_s = fr;
+    start = xyz_pos_t(from);
+    end = target;
+    length = seg_len;
+    e_per_mm = seg_e_per_mm;
+  }
+  else
+    planner.buffer_line(target, fr);
+}
+
+void MoveMerge::flush() {
+  if (!count) return;
+  count = 0; // Clear first since the planner calls back here
+  planner.buffer_line(end, fr_mm_s, extruder);
+}
+
+#endif // MERGE_COLLINEAR_MOVES
@@ -0,0 +1,67 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/move_merge.h - Join runs of short, nearly collinear moves
+ *
+ * A short linear move is held back instead of going straight to the planner.
+ * Following moves extend the held move as long as every vertex they replace
+ * stays within MERGE_MOVES_TOLERANCE of the joined line, the feedrate is the
+ * same, and the extrusion per mm matches within MERGE_MOVES_E_RATIO.
+ *
+ * The planner flushes the held move before it queues any other block or the
+ * position is changed, and loop() flushes it when no command is waiting.
+ * Commands that act at once without queueing a block (e.g., M106, M42) may
+ * still run before the held move is queued, so a setting that blocks pick up
+ * when queued, like the fan speed, can reach that move early.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+#include "../core/types.h"
+
+class MoveMerge {
+private:
+  static uint8_t count;                   // Number of moves joined into the held move
+  static uint8_t extruder;
+  static feedRate_t fr_mm_s;
+  static float length, e_per_mm;          // Joined path length and its mean E per mm
+  static xyz_pos_t start;
+  static xyze_pos_t end;
+  static xyz_pos_t vertex[(MERGE_MOVES_MAX_COUNT) - 1];
+
+  static bool can_join(const xyze_pos_t &target, const float seg_len, const float seg_e_per_mm);
+
+public:
+  static bool pending() { return count != 0; }
+
+  // Queue the move from 'from' to 'target', possibly holding it to join with the next one
+  static void line_to(const xyze_pos_t &from, const xyze_pos_t &target, const_feedRate_t fr);
+
+  // Send the held move, if any, to the planner
+  static void flush();
+
+  // Forget the held move (e.g., after quick_stop)
+  static void discard() { count = 0; }
+};
+
+extern MoveMerge move_merge;
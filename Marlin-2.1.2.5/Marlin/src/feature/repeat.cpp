@@ -68,7 +68,20 @@ void Repeat::loop() {
 
 void Repeat::cancel() { for (uint8_t i = 0; i < index; ++i) marker[i].counter = 0; }
 
-void Repeat::early_parse_M808(char * const cmd) {
+void Repeat::early_parse_M808(char * const cmd OPTARG(GCODE_PARSE_ON_ENQUEUE, const bool is_record/*=false*/)) {
+  #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+    // Read a record in place, leaving the parser state alone
+    if (is_record) {
+      if (parser.record_is(cmd, 'M', 808)) {
+        const char * const l = parser.record_param(cmd, 'L');
+        if (l)
+          add_marker(card.getIndex(), uint16_t(parser.preparsed_long(l)));
+        else
+          Repeat::loop();
+      }
+      return;
+    }
+  #endif
   if (is_command_M808(cmd)) {
     DEBUG_ECHOLNPGM("Parsing \"", cmd, "\"");
     parser.parse(cmd);
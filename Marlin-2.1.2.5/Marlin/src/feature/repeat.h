@@ -44,7 +44,7 @@ public:
     return false;
   }
   static bool is_command_M808(char * const cmd) { return cmd[0] == 'M' && cmd[1] == '8' && cmd[2] == '0' && cmd[3] == '8' && !NUMERIC(cmd[4]); }
-  static void early_parse_M808(char * const cmd);
+  static void early_parse_M808(char * const cmd OPTARG(GCODE_PARSE_ON_ENQUEUE, const bool is_record=false));
   static void add_marker(const uint32_t sdpos, const uint16_t count);
   static void loop();
   static void cancel();
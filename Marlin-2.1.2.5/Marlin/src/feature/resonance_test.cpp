@@ -0,0 +1,254 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(RESONANCE_TEST)
+
+#include "resonance_test.h"
+#include "accelerometer.h"
+
+#include "../MarlinCore.h"
+#include "../module/motion.h"
+#include "../module/planner.h"
+
+ResonanceTest resonance_test;
+
+uint8_t ResonanceTest::bins; // = 0
+float ResonanceTest::min_freq, ResonanceTest::freq_step;
+float ResonanceTest::response[RESONANCE_MAX_BINS];
+float ResonanceTest::frequency, ResonanceTest::zeta;
+float ResonanceTest::remaining[NUM_SHAPING_TYPES];
+ShapingType ResonanceTest::type;
+
+/**
+ * Goertzel filter for one frequency on all three axes. Gravity and any tilt
+ * of the sensor leak into the result when the window isn't a whole number
+ * of periods, so the mean is taken out at the end. The filter is linear, so
+ * that is done by also filtering a constant 1 and subtracting its share.
+ */
+static float gz_coeff, gz_s1[3], gz_s2[3], gz_sum[3], gz_u1, gz_u2;
+static uint32_t gz_count;
+
+static void goertzel_start(const float freq) {
+  gz_coeff = 2.0f * cos(2.0f * float(M_PI) * freq / (RESONANCE_SAMPLE_RATE));
+  ZERO(gz_s1); ZERO(gz_s2); ZERO(gz_sum);
+  gz_u1 = gz_u2 = 0;
+  gz_count = 0;
+}
+
+// Feed all waiting samples to the filter
+static void goertzel_sample() {
+  accel_sample_t buf[8];
+  for (uint8_t n; (n = accelerometer.read(buf, COUNT(buf)));) {
+    for (uint8_t i = 0; i < n; ++i) {
+      const float s[3] = { buf[i].x, buf[i].y, buf[i].z };
+      for (uint8_t a = 0; a < 3; ++a) {
+        const float s0 = s[a] + gz_coeff * gz_s1[a] - gz_s2[a];
+        gz_s2[a] = gz_s1[a];
+        gz_s1[a] = s0;
+        gz_sum[a] += s[a];
+      }
+      const float u0 = 1.0f + gz_coeff * gz_u1 - gz_u2;
+      gz_u2 = gz_u1;
+      gz_u1 = u0;
+    }
+    gz_count += n;
+  }
+}
+
+// Amplitude of the test frequency over all three axes
+static float goertzel_amplitude() {
+  if (!gz_count) return 0;
+  float power = 0;
+  for (uint8_t a = 0; a < 3; ++a) {
+    const float mean = gz_sum[a] / gz_count,
+                s1 = gz_s1[a] - mean * gz_u1,
+                s2 = gz_s2[a] - mean * gz_u2;
+    power += sq(s1) + sq(s2) - gz_coeff * s1 * s2;
+  }
+  return 2.0f * SQRT(_MAX(power, 0.0f)) / gz_count;
+}
+
+/**
+ * Shake at one frequency and return the power gain. Each stroke is a
+ * quarter period of acceleration and a quarter of deceleration, so the
+ * commanded acceleration is a square wave with a fundamental of 4/π times
+ * its height.
+ */
+float ResonanceTest::shake(const AxisEnum axis, const float freq, const float accel_per_hz, const millis_t shake_ms) {
+  float accel = accel_per_hz * freq,
+        stroke = accel / (16.0f * sq(freq));
+
+  // Strokes too short for the planner get longer and harder
+  const float min_stroke = float((MIN_STEPS_PER_SEGMENT) + 1) * planner.mm_per_step[axis];
+  if (stroke < min_stroke) {
+    stroke = min_stroke;
+    accel = 16.0f * sq(freq) * stroke;
+  }
+
+  const feedRate_t fr_mm_s = accel / (4.0f * freq);
+  planner.settings.max_acceleration_mm_per_s2[axis] = CEIL(accel);
+  NOLESS(planner.settings.max_feedrate_mm_s[axis], fr_mm_s);
+  planner.settings.acceleration = planner.settings.travel_acceleration = accel;
+  planner.refresh_acceleration_rates();
+
+  const uint16_t strokes = 2 * _MAX(1, LROUND(freq * shake_ms / 1000.0f));
+  xyze_pos_t pos = current_position;
+  const float home = pos[axis];
+
+  accelerometer.start();
+  goertzel_start(freq);
+  for (uint16_t i = 0; i < strokes;) {
+    if (planner.moves_free()) {
+      pos[axis] = home + (i & 1 ? 0 : stroke);
+      planner.buffer_line(pos, fr_mm_s);
+      ++i;
+    }
+    goertzel_sample();
+    idle();
+  }
+  while (planner.busy()) { goertzel_sample(); idle(); }
+  goertzel_sample();
+
+  return sq(goertzel_amplitude() / (4.0f / float(M_PI) * accel));
+}
+
+bool ResonanceTest::run(const AxisEnum axis, const float min, const float max, const float step,
+                        const float accel_per_hz, const millis_t shake_ms
+) {
+  bins = 0;
+
+  // A shaper would filter the strokes, so it's off for the test
+  const float old_shaping = stepper.get_shaping_frequency(axis);
+  stepper.set_shaping_frequency(axis, 0);
+
+  if (!accelerometer.begin()) {
+    stepper.set_shaping_frequency(axis, old_shaping);
+    return false;
+  }
+
+  planner.synchronize();
+
+  // Nothing may smooth out the strokes. Each frequency sets its own acceleration.
+  const planner_settings_t old_settings = planner.settings;
+  planner.settings.min_segment_time_us = 0;
+  #if ENABLED(CLASSIC_JERK)
+    const auto old_jerk = planner.max_jerk;
+    planner.max_jerk[axis] = 0;
+  #endif
+
+  min_freq = min;
+  freq_step = step;
+  for (float f = min; f <= max + step * 0.01f && bins < RESONANCE_MAX_BINS; f = min + bins * step)
+    response[bins++] = shake(axis, f, accel_per_hz, shake_ms);
+
+  accelerometer.end();
+  stepper.set_shaping_frequency(axis, old_shaping);
+
+  planner.settings = old_settings;
+  TERN_(CLASSIC_JERK, planner.max_jerk = old_jerk);
+  planner.refresh_acceleration_rates();
+  return true;
+}
+
+/**
+ * Fraction of the vibration power at 'freq' left by a shaper tuned to the
+ * measured resonance. This is the free vibration after the last impulse,
+ * with each impulse decayed by the measured damping.
+ */
+float ResonanceTest::vibration(const uint8_t factor[], const uint8_t impulses, const float span, const float freq) {
+  const float omega = 2.0f * float(M_PI) * freq,
+              decay = zeta * omega,
+              omega_d = omega * SQRT(1.0f - sq(zeta)),
+              t_end = span / frequency;
+  float s = 0, c = 0;
+  for (uint8_t i = 0; i < impulses; ++i) {
+    const float t = t_end * i / (impulses - 1),
+                a = factor[i] / 128.0f * exp(-decay * (t_end - t));
+    s += a * sin(omega_d * t);
+    c += a * cos(omega_d * t);
+  }
+  return sq(s) + sq(c);
+}
+
+void ResonanceTest::analyze() {
+  if (!bins) return;
+
+  // The peak of the response, refined by a parabola through its neighbors
+  uint8_t peak = 0;
+  for (uint8_t i = 1; i < bins; ++i) if (response[i] > response[peak]) peak = i;
+  float center = peak;
+  if (peak > 0 && peak < bins - 1) {
+    const float a = response[peak - 1], b = response[peak], c = response[peak + 1], d = a - 2 * b + c;
+    if (d < 0) center += 0.5f * (a - c) / d;
+  }
+  frequency = min_freq + center * freq_step;
+
+  // Damping from the width of the peak at half power. If only one side of
+  // the peak was measured, assume the other is its mirror image.
+  const float half = response[peak] * 0.5f;
+  float lo = -1, hi = -1;
+  for (uint8_t i = peak; i > 0; --i)
+    if (response[i - 1] < half) { lo = i - 1 + (half - response[i - 1]) / (response[i] - response[i - 1]); break; }
+  for (uint8_t i = peak; i < bins - 1; ++i)
+    if (response[i + 1] < half) { hi = i + (response[i] - half) / (response[i] - response[i + 1]); break; }
+  const float width = (lo >= 0 && hi >= 0) ? hi - lo : lo >= 0 ? 2 * (center - lo) : hi >= 0 ? 2 * (hi - center) : 0;
+  zeta = width > 0 ? width * freq_step / (2 * frequency) : 0.1f;
+  LIMIT(zeta, 0.01f, 0.3f);
+
+  /**
+   * Score each shaper by the vibration it leaves, as a fraction of the
+   * vibration without shaping. The part of the response below a twentieth
+   * of the peak is motion, not vibration, and isn't counted. The resonance
+   * moves with the load and the toolhead position, so the score is the
+   * worse of the shaper tuned 5% too low and 5% too high.
+   */
+  const float floor = response[peak] / 20.0f;
+  float total = 0;
+  for (uint8_t i = 0; i < bins; ++i) total += _MAX(response[i] - floor, 0.0f);
+
+  constexpr ShapingType by_smoothing[] = { SHAPING_ZV, SHAPING_MZV, SHAPING_EI, SHAPING_2HUMP_EI };
+  for (const ShapingType t : by_smoothing) {
+    const uint8_t impulses = shaping_impulses(t);
+    if (impulses > SHAPING_MAX_IMPULSES) { remaining[t] = -1; continue; }
+    uint8_t factor[SHAPING_MAX_IMPULSES];
+    stepper.calc_shaping_factors(t, zeta, factor);
+    float worst = 0;
+    for (const float detune : { 0.95f, 1.05f }) {
+      float left = 0;
+      for (uint8_t i = 0; i < bins; ++i)
+        left += _MAX(response[i] * vibration(factor, impulses, shaping_span(t) / detune, min_freq + i * freq_step) - floor, 0.0f);
+      NOLESS(worst, left);
+    }
+    remaining[t] = total > 0 ? SQRT(worst / total) : 0;
+  }
+
+  // The least smoothing that leaves under 5%, or else the least vibration
+  type = SHAPING_ZV;
+  for (const ShapingType t : by_smoothing)
+    if (remaining[t] >= 0 && remaining[t] <= 0.05f) { type = t; return; }
+  for (const ShapingType t : by_smoothing)
+    if (remaining[t] >= 0 && remaining[t] < remaining[type]) type = t;
+}
+
+#endif // RESONANCE_TEST
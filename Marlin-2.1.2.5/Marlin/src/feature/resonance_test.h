@@ -0,0 +1,65 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * feature/resonance_test.h - Measure axis resonance and suggest input shaping
+ *
+ * The axis is shaken back and forth at each test frequency in turn. The
+ * stroke gives a triangle velocity profile, so the commanded acceleration
+ * is a square wave whose strength grows with the frequency. A Goertzel
+ * filter picks the test frequency out of the accelerometer samples, and the
+ * ratio of measured to commanded acceleration gives the response.
+ *
+ * The resonance is the peak of the response, and the damping ratio comes
+ * from the width of the peak at half power. Each shaper is then scored by
+ * how much of the measured vibration it would leave.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+#include "../core/types.h"
+#include "../module/stepper.h"
+
+class ResonanceTest {
+public:
+  static uint8_t bins;                          // Frequencies measured by the last run
+  static float min_freq, freq_step;
+  static float response[RESONANCE_MAX_BINS];    // Power gain at each frequency
+
+  // Results of analyze()
+  static float frequency, zeta;
+  static float remaining[NUM_SHAPING_TYPES];    // Vibration left by each shaper, 0 to 1. -1 if unavailable.
+  static ShapingType type;                      // The suggested shaper
+
+  // Shake 'axis' from min to max Hz. False if the accelerometer doesn't respond.
+  static bool run(const AxisEnum axis, const float min, const float max, const float step,
+                  const float accel_per_hz, const millis_t shake_ms);
+
+  // Find the resonance and choose a shaper for it
+  static void analyze();
+
+private:
+  static float shake(const AxisEnum axis, const float freq, const float accel_per_hz, const millis_t shake_ms);
+  static float vibration(const uint8_t factor[], const uint8_t impulses, const float span, const float freq);
+};
+
+extern ResonanceTest resonance_test;
@@ -80,7 +80,7 @@ void GcodeSuite::M420() {
         bedlevel.z_values[x][y] = 0.001 * random(-200, 200);
         TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, bedlevel.z_values[x][y]));
       }
-      TERN_(AUTO_BED_LEVELING_BILINEAR, bedlevel.refresh_bed_level());
+      IF_DISABLED(MESH_BED_LEVELING, bedlevel.refresh_bed_level());
       SERIAL_ECHOPGM("Simulated " STRINGIFY(GRID_MAX_POINTS_X) "x" STRINGIFY(GRID_MAX_POINTS_Y) " mesh ");
       SERIAL_ECHOPGM(" (", x_min);
       SERIAL_CHAR(','); SERIAL_ECHO(y_min);
@@ -184,7 +184,7 @@ void GcodeSuite::M420() {
               bedlevel.z_values[x][y] -= zmean;
               TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, bedlevel.z_values[x][y]));
             }
-            TERN_(AUTO_BED_LEVELING_BILINEAR, bedlevel.refresh_bed_level());
+            IF_DISABLED(MESH_BED_LEVELING, bedlevel.refresh_bed_level());
           }
 
         #endif
@@ -32,14 +32,16 @@ void GcodeSuite::M593_report(const bool forReplay/*=true*/) {
   #if ENABLED(INPUT_SHAPING_X)
     SERIAL_ECHOLNPGM("  M593 X"
       " F", stepper.get_shaping_frequency(X_AXIS),
-      " D", stepper.get_shaping_damping_ratio(X_AXIS)
+      " D", stepper.get_shaping_damping_ratio(X_AXIS),
+      " T", stepper.get_shaping_type(X_AXIS)
     );
   #endif
   #if ENABLED(INPUT_SHAPING_Y)
     TERN_(INPUT_SHAPING_X, report_echo_start(forReplay));
     SERIAL_ECHOLNPGM("  M593 Y"
       " F", stepper.get_shaping_frequency(Y_AXIS),
-      " D", stepper.get_shaping_damping_ratio(Y_AXIS)
+      " D", stepper.get_shaping_damping_ratio(Y_AXIS),
+      " T", stepper.get_shaping_type(Y_AXIS)
     );
   #endif
 }
@@ -48,7 +50,7 @@ void GcodeSuite::M593_report(const bool forReplay/*=true*/) {
  * M593: Get or Set Input Shaping Parameters
  *  D<factor>    Set the zeta/damping factor. If axes (X, Y, etc.) are not specified, set for all axes.
  *  F<frequency> Set the frequency. If axes (X, Y, etc.) are not specified, set for all axes.
- *  T[map]       Input Shaping type, 0:ZV, 1:EI, 2:2H EI (not implemented yet)
+ *  T<type>      Set the shaper type. 0:ZV, 1:EI, 2:2HUMP_EI, 3:MZV
  *  X            Set the given parameters only for the X axis.
  *  Y            Set the given parameters only for the Y axis.
  */
@@ -70,15 +72,35 @@ void GcodeSuite::M593() {
       SERIAL_ECHO_MSG("?Zeta (D) value out of range (0-1)");
   }
 
+  // The longest echo delay has to fit the shaping timer
+  auto min_freq = [](const ShapingType type) {
+    return float(uint32_t(STEPPER_TIMER_RATE)) * shaping_span(type) / shaping_time_t(-2);
+  };
+
   if (parser.seen('F')) {
     const float freq = parser.value_float();
-    constexpr float min_freq = float(uint32_t(STEPPER_TIMER_RATE) / 2) / shaping_time_t(-2);
-    if (freq == 0.0f || freq > min_freq) {
+    const ShapingType type = ShapingType(parser.byteval('T', stepper.get_shaping_type(for_X ? X_AXIS : Y_AXIS)));
+    if (freq == 0.0f || freq > min_freq(type)) {
       if (for_X) stepper.set_shaping_frequency(X_AXIS, freq);
       if (for_Y) stepper.set_shaping_frequency(Y_AXIS, freq);
     }
     else
-      SERIAL_ECHOLNPGM("?Frequency (F) must be greater than ", min_freq, " or 0 to disable");
+      SERIAL_ECHOLNPGM("?Frequency (F) must be greater than ", min_freq(type), " or 0 to disable");
+  }
+
+  if (parser.seen('T')) {
+    const ShapingType type = ShapingType(parser.value_byte());
+    if (type >= NUM_SHAPING_TYPES || shaping_impulses(type) > SHAPING_MAX_IMPULSES)
+      SERIAL_ECHOLNPGM("?Type (T) must be 0:ZV, 1:EI, 2:2HUMP_EI or 3:MZV, with up to " STRINGIFY(SHAPING_MAX_IMPULSES) " impulses");
+    else {
+      const float freq = stepper.get_shaping_frequency(for_X ? X_AXIS : Y_AXIS);
+      if (freq && freq <= min_freq(type))
+        SERIAL_ECHOLNPGM("?Frequency must be greater than ", min_freq(type), " for this type");
+      else {
+        if (for_X) stepper.set_shaping_type(X_AXIS, type);
+        if (for_Y) stepper.set_shaping_type(Y_AXIS, type);
+      }
+    }
   }
 }
 
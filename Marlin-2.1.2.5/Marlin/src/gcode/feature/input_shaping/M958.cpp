@@ -0,0 +1,133 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(RESONANCE_TEST)
+
+#include "../../gcode.h"
+#include "../../../feature/resonance_test.h"
+#include "../../../feature/accelerometer.h"
+#include "../../../module/motion.h"
+
+static void resonance_report(const AxisEnum axis, const bool apply) {
+  constexpr ShapingType by_smoothing[] = { SHAPING_ZV, SHAPING_MZV, SHAPING_EI, SHAPING_2HUMP_EI };
+  static const char * const names[] = { "ZV", "EI", "2HUMP_EI", "MZV" };
+
+  SERIAL_ECHOPGM("Resonance ", resonance_test.frequency, "Hz, damping ");
+  SERIAL_PRINT(resonance_test.zeta, 3);
+  SERIAL_EOL();
+  SERIAL_ECHOPGM("Vibration left");
+  for (const ShapingType t : by_smoothing) {
+    if (resonance_test.remaining[t] < 0) continue;
+    SERIAL_CHAR(' ');
+    SERIAL_ECHO(names[t]);
+    SERIAL_ECHOPGM(":", int(LROUND(resonance_test.remaining[t] * 100)), "%");
+  }
+  SERIAL_EOL();
+
+  const ShapingType type = resonance_test.type;
+  SERIAL_ECHOPGM("Suggested: M593 ", C(AXIS_CHAR(axis)), " F", resonance_test.frequency, " D");
+  SERIAL_PRINT(resonance_test.zeta, 3);
+  SERIAL_ECHOLNPGM(" T", type);
+
+  if (!apply) return;
+
+  // The longest echo delay has to fit the shaping timer
+  const float min_freq = float(uint32_t(STEPPER_TIMER_RATE)) * shaping_span(type) / shaping_time_t(-2);
+  if (resonance_test.frequency < min_freq) {
+    SERIAL_ECHO_MSG("?Frequency too low for the shaper (min ", min_freq, ")");
+    return;
+  }
+  stepper.set_shaping_type(axis, type);
+  stepper.set_shaping_frequency(axis, resonance_test.frequency);
+  stepper.set_shaping_damping_ratio(axis, resonance_test.zeta);
+}
+
+/**
+ * M958: Measure resonance and suggest Input Shaping settings
+ *  X            Test the X axis. If neither X nor Y is given, test every shaped axis.
+ *  Y            Test the Y axis.
+ *  L<freq>      Lowest test frequency (Hz)
+ *  H<freq>      Highest test frequency (Hz)
+ *  S<step>      Frequency step (Hz)
+ *  A<accel>     Shaking acceleration per Hz (mm/s²/Hz)
+ *  P<ms>        Shaking time at each frequency
+ *  R            Apply the suggested settings, as with M593
+ *  V            Report the response at every frequency
+ *
+ * The axis is shaken about the current position, so move the nozzle to the
+ * middle of the bed first.
+ */
+void GcodeSuite::M958() {
+  if (homing_needed_error()) return;
+
+  const float min = parser.floatval('L', RESONANCE_MIN_FREQ),
+              max = parser.floatval('H', RESONANCE_MAX_FREQ),
+              step = parser.floatval('S', RESONANCE_FREQ_STEP),
+              accel_per_hz = parser.floatval('A', RESONANCE_ACCEL_PER_HZ);
+  const millis_t shake_ms = parser.ulongval('P', RESONANCE_SHAKE_TIME);
+
+  if (!(min > 0 && max >= min && step > 0 && accel_per_hz > 0 && shake_ms > 0)) {
+    SERIAL_ECHO_MSG("?Bad test parameters");
+    return;
+  }
+  if ((max - min) / step >= RESONANCE_MAX_BINS) {
+    SERIAL_ECHO_MSG("?Too many test frequencies (max ", RESONANCE_MAX_BINS, ")");
+    return;
+  }
+
+  const bool seen_X = TERN0(INPUT_SHAPING_X, parser.seen_test('X')),
+             seen_Y = TERN0(INPUT_SHAPING_Y, parser.seen_test('Y')),
+             for_X = seen_X || TERN0(INPUT_SHAPING_X, (!seen_X && !seen_Y)),
+             for_Y = seen_Y || TERN0(INPUT_SHAPING_Y, (!seen_X && !seen_Y)),
+             apply = parser.boolval('R'),
+             verbose = parser.boolval('V');
+
+  for (uint8_t a = 0; a < 2; ++a) {
+    const AxisEnum axis = a ? Y_AXIS : X_AXIS;
+    if (!(a ? for_Y : for_X)) continue;
+
+    SERIAL_ECHOLNPGM("Testing ", C(AXIS_CHAR(axis)), " from ", min, " to ", max, "Hz");
+    if (!resonance_test.run(axis, min, max, step, accel_per_hz, shake_ms)) {
+      SERIAL_ECHO_MSG("?Accelerometer not responding");
+      return;
+    }
+
+    // Lost samples break up the waveform, so the response is less reliable
+    if (accelerometer.overruns)
+      SERIAL_ECHO_MSG("?Accelerometer FIFO overran ", accelerometer.overruns, " times. Samples were lost.");
+    if (verbose && accelerometer.late)
+      SERIAL_ECHOLNPGM("Accelerometer FIFO past watermark ", accelerometer.late, " times");
+
+    if (verbose) for (uint8_t i = 0; i < resonance_test.bins; ++i) {
+      SERIAL_ECHOPGM("  ", min + i * step, "Hz ");
+      SERIAL_PRINT(resonance_test.response[i], 4);
+      SERIAL_EOL();
+    }
+
+    resonance_test.analyze();
+    resonance_report(axis, apply);
+  }
+}
+
+#endif // RESONANCE_TEST
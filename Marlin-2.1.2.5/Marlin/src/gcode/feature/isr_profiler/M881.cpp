@@ -0,0 +1,51 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+
+#include "../../gcode.h"
+#include "../../../feature/isr_profiler.h"
+
+/**
+ * M881: Report the stepper ISR cycle profile
+ *  C   Set the multistepping limits from the measured ISR times. (Requires CALIBRATE_MULTISTEPPING)
+ *  R   Clear the histograms after reporting
+ *  V   Also report the count in every histogram bucket
+ */
+void GcodeSuite::M881() {
+  isr_profiler.report(parser.boolval('V'));
+
+  #if ENABLED(CALIBRATE_MULTISTEPPING)
+    if (parser.seen_test('C')) {
+      if (isr_profiler.calibrate_multistepping())
+        SERIAL_ECHOLNPGM("Multistepping limits set. Use M500 to save.");
+      else
+        SERIAL_ECHO_MSG("?Too few steps measured. Make some fast moves first.");
+    }
+  #endif
+
+  if (parser.seen_test('R')) isr_profiler.reset();
+}
+
+#endif // STEPPER_ISR_PROFILE
@@ -1050,10 +1050,18 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 869: M869(); break;                                  // M869: Report axis error
       #endif
 
+      #if ENABLED(STEPPER_ISR_PROFILE)
+        case 881: M881(); break;                                  // M881: Report stepper ISR cycle histograms
+      #endif
+
       #if ENABLED(MAGNETIC_PARKING_EXTRUDER)
         case 951: M951(); break;                                  // M951: Set Magnetic Parking Extruder parameters
       #endif
 
+      #if ENABLED(RESONANCE_TEST)
+        case 958: M958(); break;                                  // M958: Measure resonance and suggest input shaping
+      #endif
+
       #if ENABLED(Z_STEPPER_AUTO_ALIGN)
         case 422: M422(); break;                                  // M422: Set Z Stepper automatic alignment position using probe
       #endif
@@ -1114,7 +1122,8 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
 
     default:
       #if ENABLED(WIFI_CUSTOM_COMMAND)
-        if (wifi_custom_command(parser.command_ptr)) break;
+        // A pre-parsed record isn't text for the WiFi module
+        if (!TERN0(HAS_PREPARSED_GCODE, parser.preparsed) && wifi_custom_command(parser.command_ptr)) break;
       #endif
       parser.unknown_command_warning();
   }
@@ -1141,7 +1150,14 @@ void GcodeSuite::process_next_command() {
 
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
-    SERIAL_ECHOLN(command.buffer);
+    #if ENABLED(SD_PREPARSED_GCODE)
+      if (command.preparsed) {
+        parser.echo_preparsed(command.buffer);
+        SERIAL_EOL();
+      }
+      else
+    #endif
+        SERIAL_ECHOLN(command.buffer);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPGM("slot:", queue.ring_buffer.index_r);
       M100_dump_routine(F("   Command Queue:"), (const char*)&queue.ring_buffer, sizeof(queue.ring_buffer));
@@ -1149,7 +1165,12 @@ void GcodeSuite::process_next_command() {
   }
 
   // Parse the next command in the queue
-  parser.parse(command.buffer);
+  #if HAS_PREPARSED_GCODE
+    if (char * const record = command.record())
+      parser.parse_preparsed(record);
+    else
+  #endif
+      parser.parse(command.buffer);
   process_parsed_command();
 }
 
@@ -1164,7 +1185,7 @@ void GcodeSuite::process_next_command() {
  */
 void GcodeSuite::process_subcommands_now(FSTR_P fgcode) {
   PGM_P pgcode = FTOP(fgcode);
-  char * const saved_cmd = parser.command_ptr;        // Save the parser state
+  const GCodeParser::saved_t saved = parser.save();   // Save the parser state
   for (;;) {
     PGM_P const delim = strchr_P(pgcode, '\n');       // Get address of next newline
     const size_t len = delim ? delim - pgcode : strlen_P(pgcode); // Get the command length
@@ -1176,13 +1197,13 @@ void GcodeSuite::process_subcommands_now(FSTR_P fgcode) {
     if (!delim) break;                                // Last command?
     pgcode = delim + 1;                               // Get the next command
   }
-  parser.parse(saved_cmd);                            // Restore the parser state
+  parser.restore(saved);                              // Restore the parser state
 }
 
 #pragma GCC diagnostic pop
 
 void GcodeSuite::process_subcommands_now(char * gcode) {
-  char * const saved_cmd = parser.command_ptr;        // Save the parser state
+  const GCodeParser::saved_t saved = parser.save();   // Save the parser state
   for (;;) {
     char * const delim = strchr(gcode, '\n');         // Get address of next newline
     if (delim) *delim = '\0';                         // Replace with nul
@@ -1192,7 +1213,7 @@ void GcodeSuite::process_subcommands_now(char * gcode) {
     *delim = '\n';                                    // Put back the newline
     gcode = delim + 1;                                // Get the next command
   }
-  parser.parse(saved_cmd);                            // Restore the parser state
+  parser.restore(saved);                              // Restore the parser state
 }
 
 #if ENABLED(HOST_KEEPALIVE_FEATURE)
@@ -289,6 +289,7 @@
  *
  * M871 - Print/reset/clear first layer temperature offset values. (Requires PTC_PROBE, PTC_BED, or PTC_HOTEND)
  * M876 - Handle Prompt Response. (Requires HOST_PROMPT_SUPPORT and not EMERGENCY_PARSER)
+ * M881 - Report stepper ISR cycle histograms. (Requires STEPPER_ISR_PROFILE)
  * M900 - Get or Set Linear Advance K-factor. (Requires LIN_ADVANCE)
  * M906 - Set or get motor current in milliamps using axis codes XYZE, etc. Report values if no axis codes given. (Requires at least one _DRIVER_TYPE defined as TMC2130/2160/5130/5160/2208/2209/2660)
  * M907 - Set digital trimpot motor current using axis codes. (Requires a board with digital trimpots)
@@ -302,6 +303,7 @@
  * M919 - Get or Set motor Chopper Times (time_off, hysteresis_end, hysteresis_start) using axis codes XYZE, etc. If no parameters are given, report. (Requires at least one _DRIVER_TYPE defined as TMC2130/2160/5130/5160/2208/2209/2660)
  * M936 - OTA update firmware. (Requires OTA_FIRMWARE_UPDATE)
  * M951 - Set Magnetic Parking Extruder parameters. (Requires MAGNETIC_PARKING_EXTRUDER)
+ * M958 - Measure resonance and suggest input shaping. (Requires RESONANCE_TEST)
  * M3426 - Read MCP3426 ADC over I2C. (Requires HAS_MCP3426_ADC)
  * M7219 - Control Max7219 Matrix LEDs. (Requires MAX7219_GCODE)
  *
@@ -1160,6 +1162,10 @@ private:
     static void M871();
   #endif
 
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    static void M881();
+  #endif
+
   #if ENABLED(LIN_ADVANCE)
     static void M900();
     static void M900_report(const bool forReplay=true);
@@ -1206,6 +1212,10 @@ private:
     static void M951();
   #endif
 
+  #if ENABLED(RESONANCE_TEST)
+    static void M958();
+  #endif
+
   #if ENABLED(TOUCH_SCREEN_CALIBRATION)
     static void M995();
   #endif
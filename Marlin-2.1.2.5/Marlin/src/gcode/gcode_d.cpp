@@ -178,6 +178,12 @@ void GcodeSuite::D(const int16_t dcode) {
       SERIAL_ECHOLN(gtn(&SERIAL_IMPL));
       break;
 
+    #if ENABLED(THERMISTOR_DIRECT_LOOKUP)
+      case 8: // D8 Benchmark thermistor table lookup
+        thermalManager.benchmark_thermistor_lookup();
+        break;
+    #endif
+
     case 100: { // D100 Disable heaters and attempt a hard hang (Watchdog Test)
       SERIAL_ECHOLNPGM("Disabling heaters and attempting to trigger Watchdog");
       SERIAL_ECHOLNPGM("(USE_WATCHDOG " TERN(USE_WATCHDOG, "ENABLED", "DISABLED") ")");
@@ -28,10 +28,20 @@
  *
  * Parameters:
  *   N<int>  Number to set as last-processed command
+ *   W<bool> Windowed acknowledgement. Requires SERIAL_WINDOWED_OK.
+ *           Reply with "Window:<lines>", the number of lines the host may have in flight.
  */
 void GcodeSuite::M110() {
 
   if (parser.seenval('N'))
     queue.set_current_line_number(parser.value_long());
 
+  #if ENABLED(SERIAL_WINDOWED_OK)
+    if (parser.seen('W')) {
+      const bool onoff = parser.value_bool();
+      queue.set_windowed_ok(onoff);
+      if (onoff) SERIAL_ECHOLNPGM("Window:", BUFSIZE);
+    }
+  #endif
+
 }
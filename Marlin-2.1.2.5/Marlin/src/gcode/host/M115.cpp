@@ -113,6 +113,9 @@ void GcodeSuite::M115() {
     // SERIAL_XON_XOFF
     cap_line(F("SERIAL_XON_XOFF"), ENABLED(SERIAL_XON_XOFF));
 
+    // WINDOWED_OK (M110 W1)
+    cap_line(F("WINDOWED_OK"), ENABLED(SERIAL_WINDOWED_OK));
+
     // BINARY_FILE_TRANSFER (M28 B1)
     cap_line(F("BINARY_FILE_TRANSFER"), ENABLED(BINARY_FILE_TRANSFER)); // TODO: Use SERIAL_IMPL.has_feature(port, SerialFeature::BinaryFileTransfer) once implemented
 
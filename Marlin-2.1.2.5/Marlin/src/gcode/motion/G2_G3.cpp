@@ -45,6 +45,25 @@
 #define ARC_LIJKUVW_CODE(L,I,J,K,U,V,W)    CODE_N(SUB2(NUM_AXES),L,I,J,K,U,V,W)
 #define ARC_LIJKUVWE_CODE(L,I,J,K,U,V,W,E) ARC_LIJKUVW_CODE(L,I,J,K,U,V,W); CODE_ITEM_E(E)
 
+#ifdef ARC_CHORD_TOLERANCE
+
+  // A fixed-point value below 2^30 in magnitude, split into a signed high part and 15-bit low part
+  typedef struct { int16_t hi; uint16_t lo; } split_fixed_t;
+
+  FORCE_INLINE split_fixed_t split_fixed(const int32_t v) { return { int16_t(v >> 15), uint16_t(v & 0x7FFF) }; }
+
+  /**
+   * Multiply a value by a Q30 factor, rounded, using only 16x16->32-bit multiplies
+   * so 8-bit AVR avoids the 32- and 64-bit multiply library calls. The product of
+   * the low parts only adds its carry. For |v| < 2^29 no partial sum overflows.
+   */
+  FORCE_INLINE int32_t mul_q30(const split_fixed_t &v, const split_fixed_t &q) {
+    return int32_t(v.hi) * q.hi
+         + ((int32_t(v.hi) * q.lo + int32_t(q.hi) * v.lo + int32_t((uint32_t(v.lo) * q.lo) >> 15) + _BV32(14)) >> 15);
+  }
+
+#endif
+
 /**
  * Plan an arc in 2 dimensions, with linear motion in the other axes.
  * The arc is traced with many small linear segments according to the configuration.
@@ -214,23 +233,46 @@ void plan_arc(
   // Feedrate for the move, scaled by the feedrate multiplier
   const feedRate_t scaled_fr_mm_s = MMS_SCALED(feedrate_mm_s);
 
-  // Get the ideal segment length for the move based on settings
-  const float ideal_segment_mm = (
-    #if ARC_SEGMENTS_PER_SEC  // Length based on segments per second and feedrate
-      constrain(scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM)
-    #else
-      MAX_ARC_SEGMENT_MM      // Length using the maximum segment size
-    #endif
-  );
+  #ifdef ARC_CHORD_TOLERANCE
+
+    // Longest chord that strays no more than ARC_CHORD_TOLERANCE from the arc,
+    // so large radii get long segments and small radii get short ones.
+    const float chord_mm = radius > (ARC_CHORD_TOLERANCE)
+      ? 2 * SQRT((ARC_CHORD_TOLERANCE) * (2 * radius - (ARC_CHORD_TOLERANCE)))
+      : flat_mm;
 
-  // Number of whole segments based on the ideal segment length
-  const float nominal_segments = _MAX(FLOOR(flat_mm / ideal_segment_mm), min_segments),
-              nominal_segment_mm = flat_mm / nominal_segments;
+    // Never go below MIN_ARC_SEGMENT_MM or, at high feedrates, above ARC_SEGMENTS_PER_SEC.
+    // Never go above ARC_CHORD_MAX_SEGMENT_MM, which takes the place of MAX_ARC_SEGMENT_MM.
+    const float segment_limit_mm = _MIN(_MAX(chord_mm, MIN_ARC_SEGMENT_MM
+      #if ARC_SEGMENTS_PER_SEC
+        , scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC)
+      #endif
+    ), ARC_CHORD_MAX_SEGMENT_MM);
+
+    const uint16_t segments = _MAX(CEIL(flat_mm / segment_limit_mm), min_segments);
+
+  #else
+
+    // Get the ideal segment length for the move based on settings
+    const float ideal_segment_mm = (
+      #if ARC_SEGMENTS_PER_SEC  // Length based on segments per second and feedrate
+        constrain(scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM)
+      #else
+        MAX_ARC_SEGMENT_MM      // Length using the maximum segment size
+      #endif
+    );
+
+    // Number of whole segments based on the ideal segment length
+    const float nominal_segments = _MAX(FLOOR(flat_mm / ideal_segment_mm), min_segments),
+                nominal_segment_mm = flat_mm / nominal_segments;
+
+    // The number of whole segments in the arc, with best attempt to honor MIN_ARC_SEGMENT_MM and MAX_ARC_SEGMENT_MM
+    const uint16_t segments = nominal_segment_mm > (MAX_ARC_SEGMENT_MM) ? CEIL(flat_mm / (MAX_ARC_SEGMENT_MM)) :
+                              nominal_segment_mm < (MIN_ARC_SEGMENT_MM) ? _MAX(1, FLOOR(flat_mm / (MIN_ARC_SEGMENT_MM))) :
+                              nominal_segments;
+
+  #endif
 
-  // The number of whole segments in the arc, with best attempt to honor MIN_ARC_SEGMENT_MM and MAX_ARC_SEGMENT_MM
-  const uint16_t segments = nominal_segment_mm > (MAX_ARC_SEGMENT_MM) ? CEIL(flat_mm / (MAX_ARC_SEGMENT_MM)) :
-                            nominal_segment_mm < (MIN_ARC_SEGMENT_MM) ? _MAX(1, FLOOR(flat_mm / (MIN_ARC_SEGMENT_MM))) :
-                            nominal_segments;
   const float segment_mm = flat_mm / segments;
 
   // Add hints to help optimize the move
@@ -264,6 +306,12 @@ void plan_arc(
    * without the initial overhead of computing cos() or sin(). By the time the arc needs to be applied
    * a correction, the planner should have caught up to the lag caused by the initial plan_arc overhead.
    * This is important when there are successive arc motions.
+   *
+   * With ARC_CHORD_TOLERANCE the radius vector is instead rotated in fixed point, scaled so the radius
+   * fills 29 bits, by a Q30 matrix whose cosine comes from 1 - 2sin²(θ/2) to keep cos² + sin² at 1 to
+   * within a few units in 2^30. The error stays near one unit per segment without ever calling sin()
+   * or cos() again, so N_ARC_CORRECTION is not needed. Each product is built from 16x16-bit multiplies
+   * (see mul_q30) so the loop stays cheap on AVR.
    */
 
   xyze_pos_t raw;
@@ -271,10 +319,21 @@ void plan_arc(
   // Don't calculate rotation parameters for trivial single-segment arcs
   if (segments > 1) {
     // Vector rotation matrix values
-    const float theta_per_segment = angular_travel / segments,
-                sq_theta_per_segment = sq(theta_per_segment),
-                sin_T = theta_per_segment - sq_theta_per_segment * theta_per_segment / 6,
-                cos_T = 1 - 0.5f * sq_theta_per_segment; // Small angle approximation
+    const float theta_per_segment = angular_travel / segments;
+    #ifdef ARC_CHORD_TOLERANCE
+      int radius_exp;
+      frexpf(radius, &radius_exp);
+      const float to_fixed = ldexpf(1.0f, 29 - radius_exp), to_mm = 1.0f / to_fixed,
+                  sin_half_T = sin(0.5f * theta_per_segment);
+      // Keep both factors below 2^30 so their high parts fit in 16 bits
+      const split_fixed_t sin_T = split_fixed(_MIN(LROUND(2 * sin_half_T * cos(0.5f * theta_per_segment) * float(_BV32(30))), int32_t(_BV32(30) - 1))),
+                          cos_T = split_fixed(_MIN(int32_t(_BV32(30)) - LROUND(2 * sq(sin_half_T) * float(_BV32(30))), int32_t(_BV32(30) - 1)));
+      int32_t fixed_a = LROUND(rvec.a * to_fixed), fixed_b = LROUND(rvec.b * to_fixed);
+    #else
+      const float sq_theta_per_segment = sq(theta_per_segment),
+                  sin_T = theta_per_segment - sq_theta_per_segment * theta_per_segment / 6,
+                  cos_T = 1 - 0.5f * sq_theta_per_segment; // Small angle approximation
+    #endif
 
     ARC_LIJKUVWE_CODE(
       const float per_segment_L = travel_L / segments,
@@ -301,7 +360,7 @@ void plan_arc(
 
     millis_t next_idle_ms = millis() + 200UL;
 
-    #if N_ARC_CORRECTION > 1
+    #if N_ARC_CORRECTION > 1 && !defined(ARC_CHORD_TOLERANCE)
       int8_t arc_recalc_count = N_ARC_CORRECTION;
     #endif
 
@@ -324,28 +383,37 @@ void plan_arc(
         idle();
       }
 
-      #if N_ARC_CORRECTION > 1
-        if (--arc_recalc_count) {
-          // Apply vector rotation matrix to previous rvec.a / 1
-          const float r_new_Y = rvec.a * sin_T + rvec.b * cos_T;
-          rvec.a = rvec.a * cos_T - rvec.b * sin_T;
-          rvec.b = r_new_Y;
-        }
-        else
-      #endif
-      {
+      #ifdef ARC_CHORD_TOLERANCE
+        // Apply the fixed-point rotation matrix to the previous radius vector
+        const split_fixed_t prev_a = split_fixed(fixed_a), prev_b = split_fixed(fixed_b);
+        fixed_a = mul_q30(prev_a, cos_T) - mul_q30(prev_b, sin_T);
+        fixed_b = mul_q30(prev_a, sin_T) + mul_q30(prev_b, cos_T);
+        rvec.a = fixed_a * to_mm;
+        rvec.b = fixed_b * to_mm;
+      #else
         #if N_ARC_CORRECTION > 1
-          arc_recalc_count = N_ARC_CORRECTION;
+          if (--arc_recalc_count) {
+            // Apply vector rotation matrix to previous rvec.a / 1
+            const float r_new_Y = rvec.a * sin_T + rvec.b * cos_T;
+            rvec.a = rvec.a * cos_T - rvec.b * sin_T;
+            rvec.b = r_new_Y;
+          }
+          else
         #endif
-
-        // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
-        // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
-        // To reduce stuttering, the sin and cos could be computed at different times.
-        // For now, compute both at the same time.
-        const float Ti = i * theta_per_segment, cos_Ti = cos(Ti), sin_Ti = sin(Ti);
-        rvec.a = -offset[0] * cos_Ti + offset[1] * sin_Ti;
-        rvec.b = -offset[0] * sin_Ti - offset[1] * cos_Ti;
-      }
+        {
+          #if N_ARC_CORRECTION > 1
+            arc_recalc_count = N_ARC_CORRECTION;
+          #endif
+
+          // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
+          // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
+          // To reduce stuttering, the sin and cos could be computed at different times.
+          // For now, compute both at the same time.
+          const float Ti = i * theta_per_segment, cos_Ti = cos(Ti), sin_Ti = sin(Ti);
+          rvec.a = -offset[0] * cos_Ti + offset[1] * sin_Ti;
+          rvec.b = -offset[0] * sin_Ti - offset[1] * cos_Ti;
+        }
+      #endif
 
       // Update raw location
       raw[axis_p] = center_P + rvec.a;
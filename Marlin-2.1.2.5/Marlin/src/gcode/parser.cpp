@@ -66,6 +66,10 @@ uint16_t GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if HAS_PREPARSED_GCODE
+  bool GCodeParser::preparsed;     // command_ptr is a pre-parsed record
+#endif
+
 // Create a global instance of the G-Code parser singleton
 GCodeParser parser;
 
@@ -80,6 +84,7 @@ void GCodeParser::reset() {
   command_letter = '?';                 // No command letter
   codenum = 0;                          // No command code
   TERN_(USE_GCODE_SUBCODES, subcode = 0); // No command sub-code
+  TERN_(HAS_PREPARSED_GCODE, preparsed = false); // Not a pre-parsed record
   #if ENABLED(FASTER_GCODE_PARSER)
     codebits = 0;                       // No codes yet
     //ZERO(param);                      // No parameters (should be safe to comment out this line)
@@ -367,10 +372,243 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if HAS_PREPARSED_GCODE
+
+  /**
+   * A pre-parsed record replaces a line of G-code with the results of parse()
+   * so handlers can skip the text scan and strtof. Records are written by
+   * buildroot/share/scripts/gcode_preparse.py (SD_PREPARSED_GCODE) or by
+   * preparse() as commands are queued. All values are little-endian.
+   *
+   *   letter | 0x80, length of the rest, code (16 bits, bit 15 = subcode follows), [subcode]
+   *   then for each parameter a tag byte (kind << 5 | letter - 'A') and its value
+   *
+   * Kinds: 0 = no value, 1 = int8, 2 = int16, 3 = int32,
+   *        4 = int16 / 1000, 5 = int32 / 1000, 6 = int32 / 100000, 7 = float
+   */
+  static constexpr uint8_t preparsed_size[8] = { 0, 1, 2, 4, 2, 4, 4, 4 };
+
+  // The end of a record, never past the end of a command buffer
+  static const uint8_t* record_end(const char * const p) {
+    return (uint8_t*)p + 2 + _MIN(uint8_t(p[1]), MAX_CMD_SIZE - 2);
+  }
+
+  void GCodeParser::parse_preparsed(char * const p) {
+    reset();
+    preparsed = true;
+    command_ptr = p;
+    command_letter = p[0] & 0x7F;
+
+    const uint8_t *q = (uint8_t*)p + 2, * const end = record_end(p);
+    codenum = q[0] | (q[1] & 0x7F) << 8;
+    if (TEST(q[1], 7)) { TERN_(USE_GCODE_SUBCODES, subcode = q[2]); ++q; }
+    q += 2;
+
+    #if ENABLED(GCODE_MOTION_MODES)
+      if (command_letter == 'G'
+        && (codenum <= TERN(ARC_SUPPORT, 3, 1) || TERN0(BEZIER_CURVE_SUPPORT, codenum == 5) || TERN0(G38_PROBE_TARGET, codenum == 38))
+      ) {
+        motion_mode_codenum = codenum;
+        TERN_(USE_GCODE_SUBCODES, motion_mode_subcode = subcode);
+      }
+    #endif
+
+    // Flag each parameter and point to its tag, or 0 for no value
+    for (; q < end && q + preparsed_size[*q >> 5] < end; q += 1 + preparsed_size[*q >> 5]) {
+      const uint8_t ind = *q & 0x1F;
+      if (ind >= COUNT(param)) continue;
+      SBI32(codebits, ind);
+      param[ind] = (*q >> 5) ? q - (uint8_t*)p : 0;
+    }
+  }
+
+  // The raw integer following a tag
+  static int32_t preparsed_raw(const uint8_t * const v) {
+    switch (preparsed_size[v[0] >> 5]) {
+      case 1: return int8_t(v[1]);
+      case 2: return int16_t(v[1] | v[2] << 8);
+      case 4: return int32_t(uint32_t(v[1]) | uint32_t(v[2]) << 8 | uint32_t(v[3]) << 16 | uint32_t(v[4]) << 24);
+    }
+    return 0;
+  }
+
+  // Dividing (not multiplying) gives the same float as strtof for the original text
+  float GCodeParser::preparsed_float(const char * const v) {
+    switch (uint8_t(v[0]) >> 5) {
+      case 4: case 5: return preparsed_raw((uint8_t*)v) / 1000.0f;
+      case 6: return preparsed_raw((uint8_t*)v) / 100000.0f;
+      case 7: { float f; memcpy(&f, v + 1, sizeof(f)); return f; }
+    }
+    return preparsed_raw((uint8_t*)v);
+  }
+
+  // Truncate like strtol
+  int32_t GCodeParser::preparsed_long(const char * const v) {
+    switch (uint8_t(v[0]) >> 5) {
+      case 4: case 5: return preparsed_raw((uint8_t*)v) / 1000;
+      case 6: return preparsed_raw((uint8_t*)v) / 100000;
+      case 7: return int32_t(preparsed_float(v));
+    }
+    return preparsed_raw((uint8_t*)v);
+  }
+
+  const char* GCodeParser::record_param(const char * const r, const char c) {
+    const uint8_t *q = (uint8_t*)r + 2, * const end = record_end(r);
+    for (q += TEST(q[1], 7) ? 3 : 2; q < end && q + preparsed_size[*q >> 5] < end; q += 1 + preparsed_size[*q >> 5])
+      if ((*q & 0x1F) == LETTER_BIT(c)) return (const char*)q;
+    return nullptr;
+  }
+
+  // Print a record as a G-code line, for echo and errors
+  void GCodeParser::echo_preparsed(const char * const p) {
+    const uint8_t *q = (uint8_t*)p + 2, * const end = record_end(p);
+    SERIAL_CHAR(p[0] & 0x7F);
+    SERIAL_ECHO(q[0] | (q[1] & 0x7F) << 8);
+    if (TEST(q[1], 7)) { SERIAL_CHAR('.'); SERIAL_ECHO(q[2]); ++q; }
+    for (q += 2; q < end && q + preparsed_size[*q >> 5] < end; q += 1 + preparsed_size[*q >> 5]) {
+      SERIAL_CHAR(' ', 'A' + (*q & 0x1F));
+      const uint8_t kind = *q >> 5;
+      if (kind >= 4) SERIAL_PRINT(preparsed_float((const char*)q), 5);
+      else if (kind) SERIAL_ECHO(preparsed_raw(q));
+    }
+  }
+
+  #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+
+    /**
+     * Get a number as the smallest record value that gives the same float as strtof.
+     * Return the tag kind, or 0 if the text should be left to parse().
+     */
+    static uint8_t preparse_value(const char * &p, int32_t &raw) {
+      const char * const start = p;
+      const bool neg = *p == '-';
+      if (neg || *p == '+') ++p;
+      uint32_t v = 0, ipart = 0;
+      uint8_t decimals = 0;
+      bool point = false;
+      for (;; ++p) {
+        if (NUMERIC(*p)) {
+          if (v > (UINT32_MAX - 9) / 10) return 0;  // Too many digits. Leave it to strtof and strtol.
+          v = v * 10 + (*p - '0');
+          if (point) ++decimals;
+        }
+        else if (*p == '.' && !point) {
+          point = true;
+          ipart = v;
+        }
+        else
+          break;
+      }
+      if (!point) ipart = v;
+      while (decimals && v % 10 == 0) { v /= 10; --decimals; }
+
+      if (decimals == 0 && v <= INT32_MAX) {
+        raw = neg ? -int32_t(v) : int32_t(v);
+        return WITHIN(raw, -128, 127) ? 1 : WITHIN(raw, -32768, 32767) ? 2 : 3;
+      }
+
+      // Below 2^24 the scaled integer is an exact float, so the division rounds like strtof
+      if (decimals <= 5) {
+        for (uint8_t d = decimals; d < (decimals <= 3 ? 3 : 5) && v < _BV32(24); ++d) v *= 10;
+        if (v < _BV32(24)) {
+          raw = neg ? -int32_t(v) : int32_t(v);
+          return decimals > 3 ? 6 : WITHIN(raw, -32768, 32767) ? 4 : 5;
+        }
+      }
+
+      // A float truncates like strtol below 2^24
+      if (ipart >= _BV32(24)) return 0;
+      char *e;
+      const float f = strtof(start, &e);
+      if (e != p) return 0;                       // An exponent that value_float() would ignore
+      memcpy(&raw, &f, sizeof(raw));
+      return 7;
+    }
+
+    /**
+     * Store a record for a G, M, or T command with only numeric parameters after
+     * its text. Commands that use string_arg, chained commands, and anything
+     * parse() treats specially are left as text. Return the record's offset or 0.
+     */
+    uint8_t GCodeParser::preparse(char (&buff)[MAX_CMD_SIZE]) {
+      auto uppercase = [](char c) {
+        return TERN0(GCODE_CASE_INSENSITIVE, WITHIN(c, 'a', 'z')) ? c + 'A' - 'a' : c;
+      };
+
+      const char *p = buff;
+      while (*p == ' ') ++p;
+      if (uppercase(*p) == 'N' && NUMERIC_SIGNED(p[1])) {
+        p += 2;
+        while (NUMERIC(*p)) ++p;
+        while (*p == ' ') ++p;
+      }
+
+      const char letter = uppercase(*p++);
+      if (letter != 'G' && letter != 'M' && letter != 'T') return 0;
+      while (*p == ' ') ++p;
+      if (!NUMERIC(*p)) return 0;
+      uint32_t code = 0;
+      do {
+        code = code * 10 + *p++ - '0';
+        if (code > 0x7FFF) return 0;
+      } while (NUMERIC(*p));
+
+      // Leave commands that read string_arg or the rest of the line as text
+      if (letter == 'M') switch (code) {
+        TERN_(GCODE_MACROS, case 810 ... 819:)
+        case 0 ... 1: case 16: case 23: case 28 ... 33: case 75: case 117 ... 118: case 552 ... 554: case 928:
+          return 0;
+      }
+      if (TERN0(CNC_COORDINATE_SYSTEMS, letter == 'G' && code == 53)) return 0;
+
+      const uint8_t start = strlen(buff) + 1;
+      uint8_t * const r = (uint8_t*)buff + start, *q = r + 2;
+      const uint8_t * const end = (uint8_t*)buff + MAX_CMD_SIZE;
+      if (q + 3 > end) return 0;
+      *q++ = code & 0xFF;
+      *q++ = code >> 8;
+
+      if (*p == '.') {
+        #if USE_GCODE_SUBCODES
+          uint16_t sub = 0;
+          while (NUMERIC(*++p)) if ((sub = sub * 10 + *p - '0') > 0xFF) return 0;
+          q[-1] |= 0x80;
+          *q++ = sub;
+        #else
+          return 0;
+        #endif
+      }
+      while (*p == ' ') ++p;
+
+      while (*p && *p != '*') {
+        const char c = uppercase(*p++);
+        if (!WITHIN(c, 'A', 'Z')) return 0;
+        while (*p == ' ') ++p;
+        int32_t raw = 0;
+        uint8_t kind = 0;
+        if (valid_float(p) && !(kind = preparse_value(p, raw))) return 0;
+        const uint8_t size = preparsed_size[kind];
+        if (q + 1 + size > end) return 0;
+        *q++ = kind << 5 | LETTER_BIT(c);
+        for (uint8_t i = 0; i < size; ++i) *q++ = uint32_t(raw) >> (8 * i);
+        if (*p && *p != ' ' && *p != '*' && !WITHIN(uppercase(*p), 'A', 'Z')) return 0;
+        while (*p == ' ') ++p;
+      }
+
+      r[0] = letter | 0x80;
+      r[1] = q - r - 2;
+      return start;
+    }
+
+  #endif // GCODE_PARSE_ON_ENQUEUE
+
+#endif // HAS_PREPARSED_GCODE
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
   bool GCodeParser::chain() {
+    if (TERN0(HAS_PREPARSED_GCODE, preparsed)) return false; // Records hold a single command
     #if ENABLED(FASTER_GCODE_PARSER)
       char *next_command = command_ptr;
       if (next_command) {
@@ -388,6 +626,16 @@ void GCodeParser::parse(char *p) {
 #endif // CNC_COORDINATE_SYSTEMS
 
 void GCodeParser::unknown_command_warning() {
+  #if HAS_PREPARSED_GCODE
+    if (preparsed) {
+      SERIAL_ECHO_START();
+      SERIAL_ECHOPGM(STR_UNKNOWN_COMMAND);
+      echo_preparsed(command_ptr);
+      SERIAL_CHAR('"');
+      SERIAL_EOL();
+      return;
+    }
+  #endif
   SERIAL_ECHO_MSG(STR_UNKNOWN_COMMAND, command_ptr, "\"");
 }
 
@@ -149,7 +149,7 @@ public:
       if (b) {
         if (param[ind]) {
           char * const ptr = command_ptr + param[ind];
-          value_ptr = valid_number(ptr) ? ptr : nullptr;
+          value_ptr = (TERN0(HAS_PREPARSED_GCODE, preparsed) || valid_number(ptr)) ? ptr : nullptr;
         }
         else
           value_ptr = nullptr;
@@ -237,6 +237,44 @@ public:
   // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
+  #if HAS_PREPARSED_GCODE
+    // Populate all fields from a pre-parsed record. Only the command queue knows
+    // which buffers hold a record, so parse() never treats text as one.
+    static bool preparsed;          // The command is a pre-parsed record
+    static void parse_preparsed(char * const p);
+    static void echo_preparsed(const char * const p);
+
+    // Read a record without changing the parser state, e.g., to look ahead in the queue
+    static bool record_is(const char * const r, const char ltr, const uint16_t num) {
+      return (r[0] & 0x7F) == ltr && (uint8_t(r[2]) | (r[3] & 0x7F) << 8) == num;
+    }
+    static const char* record_param(const char * const r, const char c);   // Parameter tag or nullptr
+    static float preparsed_float(const char * const v);                     // Value after a tag
+    static int32_t preparsed_long(const char * const v);
+  #endif
+
+  // The current command, to parse it again after running others
+  typedef struct {
+    char *command_ptr;
+    #if HAS_PREPARSED_GCODE
+      bool preparsed;
+    #endif
+  } saved_t;
+
+  static saved_t save() { return { command_ptr OPTARG(HAS_PREPARSED_GCODE, preparsed) }; }
+
+  static void restore(const saved_t &s) {
+    #if HAS_PREPARSED_GCODE
+      if (s.preparsed) return parse_preparsed(s.command_ptr);
+    #endif
+    parse(s.command_ptr);
+  }
+
+  #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+    // Store a record after the text of a simple command. Return its offset or 0.
+    static uint8_t preparse(char (&buff)[MAX_CMD_SIZE]);
+  #endif
+
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
     // Parse the next parameter as a new command
     static bool chain();
@@ -257,6 +295,9 @@ public:
   // Float removes 'E' to prevent scientific notation interpretation
   static float value_float() {
     if (!value_ptr) return 0;
+    #if HAS_PREPARSED_GCODE
+      if (preparsed) return preparsed_float(value_ptr);
+    #endif
     char *e = value_ptr;
     for (;;) {
       const char c = *e;
@@ -273,8 +314,13 @@ public:
   }
 
   // Code value as a long or ulong
-  static int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  #if HAS_PREPARSED_GCODE
+    static int32_t value_long() { return value_ptr ? (preparsed ? preparsed_long(value_ptr) : strtol(value_ptr, nullptr, 10)) : 0L; }
+    static uint32_t value_ulong() { return value_ptr ? (preparsed ? uint32_t(preparsed_long(value_ptr)) : strtoul(value_ptr, nullptr, 10)) : 0UL; }
+  #else
+    static int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
+    static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  #endif
 
   // Code value for use as time
   static millis_t value_millis() { return value_ulong(); }
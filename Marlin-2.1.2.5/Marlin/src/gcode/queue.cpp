@@ -99,11 +99,30 @@ void GCodeQueue::RingBuffer::commit_command(const bool skip_ok
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
 ) {
   commands[index_w].skip_ok = skip_ok;
+  TERN_(SD_PREPARSED_GCODE, commands[index_w].preparsed = false);
+  TERN_(GCODE_PARSE_ON_ENQUEUE, commands[index_w].parsed = GCodeParser::preparse(commands[index_w].buffer));
   TERN_(HAS_MULTI_SERIAL, commands[index_w].port = serial_ind);
   TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
   advance_w();
 }
 
+#if ENABLED(SD_PREPARSED_GCODE)
+
+  /**
+   * Commit a record read from a pre-parsed SD file. This is the only
+   * way a buffer gets handed to GCodeParser::parse_preparsed as-is.
+   */
+  void GCodeQueue::RingBuffer::commit_record() {
+    commands[index_w].skip_ok = true;
+    commands[index_w].preparsed = true;
+    TERN_(GCODE_PARSE_ON_ENQUEUE, commands[index_w].parsed = 0);
+    TERN_(HAS_MULTI_SERIAL, commands[index_w].port = serial_index_t());
+    TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
+    advance_w();
+  }
+
+#endif
+
 /**
  * Copy a command from RAM into the main command buffer.
  * Return true if the command was successfully added.
@@ -236,6 +255,9 @@ void GCodeQueue::enqueue_now_P(PGM_P const pgcode) {
  *   N<int>  Line number of the command, if any
  *   P<int>  Planner space remaining
  *   B<int>  Block queue space remaining
+ *
+ * With SERIAL_WINDOWED_OK a numbered line may be held back
+ * and acknowledged along with the lines after it.
  */
 void GCodeQueue::RingBuffer::ok_to_send() {
   #if NO_TIMEOUTS > 0
@@ -249,6 +271,22 @@ void GCodeQueue::RingBuffer::ok_to_send() {
     PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));   // Reply to the serial port that sent the command
   #endif
   if (command.skip_ok) return;
+  #if ENABLED(SERIAL_WINDOWED_OK)
+    const serial_index_t port = command_port();
+    SerialState &serial = serial_state[port.index];
+    if (serial.windowed) {
+      if (command.buffer[0] == 'N') {
+        // Add the line to the range waiting to be acknowledged
+        const long n = strtol(command.buffer + 1, nullptr, 10);
+        if (serial.acks && n != serial.ack_N + serial.acks) send_acks(port);
+        if (!serial.acks++) { serial.ack_N = n; serial.ack_ms = millis(); }
+        // Hold it back while more commands are waiting, up to half the window
+        if (length <= 1 || serial.acks >= _MAX(BUFSIZE / 2, 1)) send_acks(port);
+        return;
+      }
+      send_acks(port);                            // Keep acknowledgements in order
+    }
+  #endif
   SERIAL_ECHOPGM(STR_OK);
   #if ENABLED(ADVANCED_OK)
     char* p = command.buffer;
@@ -276,6 +314,60 @@ void GCodeQueue::flush_and_request_resend(const serial_index_t serial_ind) {
   SERIAL_ECHOLNPGM(STR_OK);
 }
 
+#if ENABLED(SERIAL_WINDOWED_OK)
+
+  /**
+   * Send "Resend: Nnnn" for the first missing line on a windowed port.
+   * The input is kept, and every line after the lost one is dropped until it
+   * comes again. If nothing comes for WINDOWED_RESEND_TIMEOUT ack_task asks again.
+   */
+  void GCodeQueue::request_windowed_resend(const serial_index_t serial_ind, const long lost_N/*=0*/) {
+    PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));
+    SerialState &serial = serial_state[serial_ind.index];
+    const long n = serial.last_N + 1;
+    SERIAL_ECHOLNPGM(STR_RESEND "N", n);
+    // Lines up to the one that showed the loss were sent before the request.
+    // The host can't have sent a line more than a window ahead, so a line number beyond that is bogus.
+    serial.resend_N = WITHIN(lost_N, n + 1, n + BUFSIZE - 1) ? lost_N : n;
+    serial.resend_ms = millis();
+    serial.resending = true;
+  }
+
+  void GCodeQueue::send_acks(const serial_index_t serial_ind) {
+    SerialState &serial = serial_state[serial_ind.index];
+    if (!serial.acks) return;
+    PORT_REDIRECT(SERIAL_PORTMASK(serial_ind));
+    SERIAL_ECHOPGM(STR_OK " N", serial.ack_N);
+    if (serial.acks > 1) SERIAL_ECHOPGM("-N", serial.ack_N + serial.acks - 1);
+    #if ENABLED(ADVANCED_OK)
+      SERIAL_ECHOPGM_P(SP_P_STR, planner.moves_free(), SP_B_STR, BUFSIZE - ring_buffer.length);
+    #endif
+    SERIAL_EOL();
+    serial.acks = 0;
+  }
+
+  void GCodeQueue::ack_task() {
+    const millis_t ms = millis();
+    for (uint8_t p = 0; p < NUM_SERIAL; ++p) {
+      SerialState &serial = serial_state[p];
+      if (serial.acks && ELAPSED(ms, serial.ack_ms + WINDOWED_OK_DELAY))
+        send_acks(p);
+      // The re-sent line was lost too, and nothing came after it
+      if (serial.resending && ELAPSED(ms, serial.resend_ms + WINDOWED_RESEND_TIMEOUT))
+        request_windowed_resend(p);
+    }
+  }
+
+  void GCodeQueue::set_windowed_ok(const bool onoff) {
+    const serial_index_t port = ring_buffer.command_port();
+    SerialState &serial = serial_state[port.index];
+    if (!onoff) send_acks(port);
+    serial.windowed = onoff;
+    serial.resending = false;
+  }
+
+#endif
+
 static bool serial_data_available(serial_index_t index) {
   const int a = SERIAL_IMPL.available(index);
   #if ENABLED(RX_BUFFER_MONITOR) && RX_BUFFER_SIZE
@@ -310,6 +402,9 @@ inline int read_serial(const serial_index_t index) { return SERIAL_IMPL.read(ind
   void GCodeQueue::flush_rx() {
     // Flush receive buffer
     for (uint8_t p = 0; p < NUM_SERIAL; ++p) {
+      #if SERIAL_BLOCK_READ
+        serial_state[p].rx_count = 0;
+      #endif
       if (!serial_data_available(p)) continue; // No data for this port? Skip.
       while (SERIAL_IMPL.available(p)) (void)read_serial(p);
     }
@@ -317,12 +412,22 @@ inline int read_serial(const serial_index_t index) { return SERIAL_IMPL.read(ind
 
 #endif // (ARDUINO_ARCH_STM32F4 || ARDUINO_ARCH_STM32) && USBCON
 
-void GCodeQueue::gcode_line_error(FSTR_P const ferr, const serial_index_t serial_ind) {
+void GCodeQueue::gcode_line_error(FSTR_P const ferr, const serial_index_t serial_ind OPTARG(SERIAL_WINDOWED_OK, const long lost_N/*=0*/)) {
   PORT_REDIRECT(SERIAL_PORTMASK(serial_ind)); // Reply to the serial port that sent the command
   SERIAL_ERROR_START();
   SERIAL_ECHOLNF(ferr, serial_state[serial_ind.index].last_N);
-  while (read_serial(serial_ind) != -1) { /* nada */ } // Clear out the RX buffer. Why don't use flush here ?
-  flush_and_request_resend(serial_ind);
+  #if ENABLED(SERIAL_WINDOWED_OK)
+    if (serial_state[serial_ind.index].windowed)  // Keep the input. Lines in flight are dropped whole.
+      request_windowed_resend(serial_ind, lost_N);
+    else
+  #endif
+  {
+    while (read_serial(serial_ind) != -1) { /* nada */ } // Clear out the RX buffer. Why don't use flush here ?
+    #if SERIAL_BLOCK_READ
+      serial_state[serial_ind.index].rx_count = 0;
+    #endif
+    flush_and_request_resend(serial_ind);
+  }
   serial_state[serial_ind.index].count = 0;
 }
 
@@ -389,6 +494,45 @@ inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD
   }
 }
 
+#if SERIAL_BLOCK_READ
+
+  /**
+   * Take a run of characters from a block that process_stream_char would only copy
+   * or skip, stopping at the first one that needs it. Return the number taken.
+   */
+  inline uint8_t process_stream_run(const uint8_t * const data, const uint8_t len, uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+    uint8_t i = 0;
+    switch (sis) {
+      case PS_NORMAL: {
+        // Characters that change the input state: BS, LF, CR, ';', '\' and, if enabled, '"' and '('
+        constexpr uint32_t lo = _BV32(0x08) | _BV32('\n') | _BV32('\r'),
+                           hi = _BV32(';' - 32) | TERN0(GCODE_QUOTED_STRINGS, _BV32('"' - 32)) | TERN0(PAREN_COMMENTS, _BV32('(' - 32));
+        const int room = MAX_CMD_SIZE - 1 - ind;
+        const uint8_t end = _MIN(len, room);
+        for (; i < end; ++i) {
+          const uint8_t c = data[i];
+          if (c < 32 ? TEST32(lo, c) : c < 64 ? TEST32(hi, c - 32) : c == '\\') break;
+        }
+        memcpy(&buff[ind], data, i);
+        ind += i;
+        if (i == room) sis = PS_EOL;    // Skip the rest on overflow
+      } break;
+
+      case PS_EOL:                      // Skip a comment up to the end of the line
+        while (i < len && !ISEOL(data[i])) ++i;
+        break;
+
+      #if ENABLED(PAREN_COMMENTS)
+        case PS_PAREN:                  // Skip an inline comment up to ')' or the end of the line
+          while (i < len && data[i] != ')' && !ISEOL(data[i])) ++i;
+          break;
+      #endif
+    }
+    return i;
+  }
+
+#endif
+
 /**
  * Handle a line being completed. For an empty line
  * keep sensor readings going and watchdog alive.
@@ -441,26 +585,51 @@ void GCodeQueue::get_serial_commands() {
       // Check if the queue is full and exit if it is.
       if (ring_buffer.full()) return;
 
-      // No data for this port ? Skip it
-      if (!serial_data_available(p)) continue;
-
-      // Ok, we have some data to process, let's make progress here
-      hadData = true;
-
-      const int c = read_serial(p);
-      if (c < 0) {
-        // This should never happen, let's log it
-        PORT_REDIRECT(SERIAL_PORTMASK(p));     // Reply to the serial port that sent the command
-        // Crash here to get more information why it failed
-        BUG_ON("SP available but read -1");
-        SERIAL_ERROR_MSG(STR_ERR_SERIAL_MISMATCH);
-        SERIAL_FLUSH();
-        continue;
-      }
-
-      const char serial_char = (char)c;
       SerialState &serial = serial_state[p];
 
+      #if SERIAL_BLOCK_READ
+
+        // Get a new block when the last one is used up
+        if (serial.rx_index >= serial.rx_count) {
+          // No data for this port ? Skip it
+          if (!serial_data_available(p)) continue;
+          serial.rx_count = SERIAL_IMPL.readBlock(serial.rx_block, SERIAL_BLOCK_READ, p);
+          serial.rx_index = 0;
+        }
+
+        // Ok, we have some data to process, let's make progress here
+        hadData = true;
+
+        // Copy or skip ordinary characters in one go
+        serial.rx_index += process_stream_run(&serial.rx_block[serial.rx_index], serial.rx_count - serial.rx_index, serial.input_state, serial.line_buffer, serial.count);
+        if (serial.rx_index >= serial.rx_count) continue;
+
+        // The next character needs the state machine
+        const char serial_char = (char)serial.rx_block[serial.rx_index++];
+
+      #else
+
+        // No data for this port ? Skip it
+        if (!serial_data_available(p)) continue;
+
+        // Ok, we have some data to process, let's make progress here
+        hadData = true;
+
+        const int c = read_serial(p);
+        if (c < 0) {
+          // This should never happen, let's log it
+          PORT_REDIRECT(SERIAL_PORTMASK(p));     // Reply to the serial port that sent the command
+          // Crash here to get more information why it failed
+          BUG_ON("SP available but read -1");
+          SERIAL_ERROR_MSG(STR_ERR_SERIAL_MISMATCH);
+          SERIAL_FLUSH();
+          continue;
+        }
+
+        const char serial_char = (char)c;
+
+      #endif
+
       if (ISEOL(serial_char)) {
 
         // Reset our state, continue if the line was empty
@@ -487,8 +656,17 @@ void GCodeQueue::get_serial_commands() {
           if (gcode_N != serial.last_N + 1 && !M110) {
             // A request-for-resend line was already in transit so we got two - oops!
             if (WITHIN(gcode_N, serial.last_N - 1, serial.last_N)) continue;
+            #if ENABLED(SERIAL_WINDOWED_OK)
+              // Lines that were in flight after a resend request are dropped quietly
+              if (serial.resending && gcode_N > serial.resend_N) {
+                serial.resend_N = gcode_N;
+                serial.resend_ms = millis();
+                continue;
+              }
+              // Otherwise the host went back, but the line it went back to was lost again
+            #endif
             // A corrupted line or too high, indicating a lost line
-            gcode_line_error(F(STR_ERR_LINE_NO), p);
+            gcode_line_error(F(STR_ERR_LINE_NO), p OPTARG(SERIAL_WINDOWED_OK, gcode_N));
             break;
           }
 
@@ -507,6 +685,7 @@ void GCodeQueue::get_serial_commands() {
           }
 
           serial.last_N = gcode_N;
+          TERN_(SERIAL_WINDOWED_OK, serial.resending = false);
         }
         #if HAS_MEDIA
           // Pronterface "M29" and "M29 " has no line number
@@ -574,40 +753,83 @@ void GCodeQueue::get_serial_commands() {
 
     int sd_count = 0;
     while (!ring_buffer.full() && !card.eof()) {
-      const int16_t n = card.get();
-      const bool card_eof = card.eof();
-      if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
-
       CommandLine &command = ring_buffer.commands[ring_buffer.index_w];
-      const char sd_char = (char)n;
-      const bool is_eol = ISEOL(sd_char);
-      if (is_eol || card_eof) {
 
-        // Reset stream state, terminate the buffer, and commit a non-empty command
-        if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command.buffer, sd_count)) {
+      #if ENABLED(SD_PREPARSED_GCODE)
+        // A pre-parsed record (see GCodeParser::parse_preparsed) takes the place of a line
+        if (card.flag.preparsed && !sd_count && sd_input_state == PS_NORMAL && card.peek() >= 0x80) {
+          uint8_t * const buf = (uint8_t*)command.buffer;
+          bool ok = card.getBytes(buf, 2);
+          if (ok && buf[1] > MAX_CMD_SIZE - 2) {        // Too long for this build. Skip it.
+            card.setIndex(card.getIndex() + buf[1]);
+            ok = false;
+          }
+          if (ok && card.getBytes(buf + 2, buf[1])) {
+            ring_buffer.commit_record();
+            TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = card.getIndex());
+          }
+          else
+            SERIAL_ERROR_MSG(STR_SD_ERR_READ);
+          if (card.eof()) card.fileHasFinished();
+          continue;
+        }
+      #endif
+
+      #if ENABLED(SD_READ_AHEAD)
+
+        // Scan buffered bytes up to the end of the line
+        const uint8_t *data;
+        const uint16_t avail = card.readahead(data);
+        if (!avail) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+        uint16_t i = 0;
+        while (i < avail && !ISEOL(data[i])) process_stream_char(data[i++], sd_input_state, command.buffer, sd_count);
+        const bool is_eol = i < avail;
+        card.consume(i + is_eol);
+        if (!is_eol && !card.eof()) continue;           // The line goes on in the next run
+
+      #else
+
+        const int16_t n = card.get();
+        const bool card_eof = card.eof();
+        if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+
+        const char sd_char = (char)n;
+        const bool is_eol = ISEOL(sd_char);
+        if (!is_eol) {
+          process_stream_char(sd_char, sd_input_state, command.buffer, sd_count);
+          if (!card_eof) continue;                      // End of file with no newline falls through
+        }
+
+      #endif
+
+      // Reset stream state, terminate the buffer, and commit a non-empty command
+      if (!process_line_done(sd_input_state, command.buffer, sd_count)) {
 
+        #if DISABLED(GCODE_PARSE_ON_ENQUEUE)
           // M808 L saves the sdpos of the next line. M808 loops to a new sdpos.
           TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(command.buffer));
+        #endif
 
-          #if DISABLED(PARK_HEAD_ON_PAUSE)
-            // When M25 is non-blocking it can still suspend SD commands
-            // Otherwise the M125 handler needs to know SD printing is active
-            if (command.buffer[0] == 'M' && command.buffer[1] == '2' && command.buffer[2] == '5' && !NUMERIC(command.buffer[3]))
-              card.pauseSDPrint();
-          #endif
+        #if DISABLED(PARK_HEAD_ON_PAUSE)
+          // When M25 is non-blocking it can still suspend SD commands
+          // Otherwise the M125 handler needs to know SD printing is active
+          if (command.buffer[0] == 'M' && command.buffer[1] == '2' && command.buffer[2] == '5' && !NUMERIC(command.buffer[3]))
+            card.pauseSDPrint();
+        #endif
 
-          // Put the new command into the buffer (no "ok" sent)
-          ring_buffer.commit_command(true);
+        // Put the new command into the buffer (no "ok" sent)
+        ring_buffer.commit_command(true);
 
-          // Prime Power-Loss Recovery for the NEXT commit_command
-          TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = card.getIndex());
-        }
+        #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+          // Look at the record made on commit, if any, without parsing again
+          TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(command.buffer + command.parsed, command.parsed != 0));
+        #endif
 
-        if (card.eof()) card.fileHasFinished();         // Handle end of file reached
+        // Prime Power-Loss Recovery for the NEXT commit_command
+        TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = card.getIndex());
       }
-      else
-        process_stream_char(sd_char, sd_input_state, command.buffer, sd_count);
+
+      if (card.eof()) card.fileHasFinished();         // Handle end of file reached
     }
   }
 
@@ -620,7 +842,11 @@ void GCodeQueue::get_serial_commands() {
  *  - The SD card file being actively printed
  */
 void GCodeQueue::get_available_commands() {
-  if (ring_buffer.full()) return;
+  if (ring_buffer.full()) {
+    // Use the wait to top up the SD read-ahead buffer
+    TERN_(SD_READ_AHEAD, if (IS_SD_FETCHING()) card.readahead_fill());
+    return;
+  }
 
   get_serial_commands();
 
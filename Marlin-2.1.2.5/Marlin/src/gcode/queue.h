@@ -43,6 +43,20 @@ public:
     int count;                      //!< Number of characters read in the current line of serial input
     char line_buffer[MAX_CMD_SIZE]; //!< The current line accumulator
     uint8_t input_state;            //!< The input state
+    #if SERIAL_BLOCK_READ
+      uint8_t rx_block[SERIAL_BLOCK_READ]; //!< Bytes read from the port, not yet processed
+      uint8_t rx_index,                    //!< The next byte to process
+              rx_count;                    //!< The number of bytes in the block
+    #endif
+    #if ENABLED(SERIAL_WINDOWED_OK)
+      bool windowed,                //!< Acknowledge lines in ranges (M110 W1)
+           resending;               //!< Drop lines sent after a lost one until it comes again
+      long resend_N;                //!< The highest line number seen since the resend request
+      millis_t resend_ms;           //!< When the last line came in while resending
+      uint8_t acks;                 //!< Number of executed lines not yet acknowledged
+      long ack_N;                   //!< The first line not yet acknowledged
+      millis_t ack_ms;              //!< When that line was executed
+    #endif
   };
 
   static SerialState serial_state[NUM_SERIAL]; //!< Serial states for each serial port
@@ -59,9 +73,25 @@ public:
   struct CommandLine {
     char buffer[MAX_CMD_SIZE];      //!< The command buffer
     bool skip_ok;                   //!< Skip sending ok when command is processed?
+    #if ENABLED(SD_PREPARSED_GCODE)
+      bool preparsed;               //!< The buffer holds a record from a pre-parsed SD file
+    #endif
+    #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+      uint8_t parsed;               //!< Offset of the record made by GCodeParser::preparse, or 0
+    #endif
     #if HAS_MULTI_SERIAL
       serial_index_t port;          //!< Serial port the command was received on
     #endif
+
+    #if HAS_PREPARSED_GCODE
+      // The pre-parsed record for this command, or nullptr if it's only text
+      char* record() {
+        #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+          if (parsed) return buffer + parsed;
+        #endif
+        return TERN0(SD_PREPARSED_GCODE, preparsed) ? buffer : nullptr;
+      }
+    #endif
   };
 
   /**
@@ -85,6 +115,10 @@ public:
       OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind=serial_index_t())
     );
 
+    #if ENABLED(SD_PREPARSED_GCODE)
+      void commit_record();
+    #endif
+
     bool enqueue(const char *cmd, const bool skip_ok=true
       OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind=serial_index_t())
     );
@@ -100,6 +134,15 @@ public:
     inline CommandLine& peek_next_command() { return commands[index_r]; }
 
     inline char* peek_next_command_string() { return peek_next_command().buffer; }
+
+    #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+      // The parsed form of a queued command, 'n' after the next one, or nullptr if it's only text
+      char* peek_parsed(const uint8_t n=0) {
+        if (n >= length) return nullptr;
+        CommandLine &c = commands[(index_r + n) % BUFSIZE];
+        return c.record();
+      }
+    #endif
   };
 
   /**
@@ -194,6 +237,9 @@ public:
    *   N<int>  Line number of the command, if any
    *   P<int>  Planner space remaining
    *   B<int>  Block queue space remaining
+   *
+   * With SERIAL_WINDOWED_OK a numbered line may be held back
+   * and acknowledged along with the lines after it.
    */
   static void ok_to_send() { ring_buffer.ok_to_send(); }
 
@@ -203,6 +249,25 @@ public:
    */
   static void flush_and_request_resend(const serial_index_t serial_ind);
 
+  #if ENABLED(SERIAL_WINDOWED_OK)
+    /**
+     * Send "ok N<first>-N<last>" for the lines executed
+     * but not yet acknowledged on the given port.
+     */
+    static void send_acks(const serial_index_t serial_ind);
+
+    /**
+     * Send acknowledgements held back for too long
+     * and ask again for a lost line that never came
+     */
+    static void ack_task();
+
+    /**
+     * Turn windowed acknowledgement on or off for the port of the current command
+     */
+    static void set_windowed_ok(const bool onoff);
+  #endif
+
   #if (defined(ARDUINO_ARCH_STM32F4) || defined(ARDUINO_ARCH_STM32)) && defined(USBCON)
     static void flush_rx();
   #else
@@ -268,7 +333,12 @@ private:
   // Process the next "immediate" command (SRAM)
   static bool process_injected_command();
 
-  static void gcode_line_error(FSTR_P const ferr, const serial_index_t serial_ind);
+  static void gcode_line_error(FSTR_P const ferr, const serial_index_t serial_ind OPTARG(SERIAL_WINDOWED_OK, const long lost_N=0));
+
+  #if ENABLED(SERIAL_WINDOWED_OK)
+    // Ask a windowed host to go back to a lost line, and ask again if it doesn't come
+    static void request_windowed_resend(const serial_index_t serial_ind, const long lost_N=0);
+  #endif
 
   friend class GcodeSuite;
 };
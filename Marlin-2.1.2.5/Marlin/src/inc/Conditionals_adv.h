@@ -858,6 +858,10 @@
   #define HAS_MEDIA_SUBCALLS 1
 #endif
 
+#if ANY(SD_PREPARSED_GCODE, GCODE_PARSE_ON_ENQUEUE)
+  #define HAS_PREPARSED_GCODE 1
+#endif
+
 #if HAS_PRINT_PROGRESS && ANY(PRINT_PROGRESS_SHOW_DECIMALS, SHOW_REMAINING_TIME)
   #define HAS_PRINT_PROGRESS_PERMYRIAD 1
 #endif
@@ -1286,4 +1290,13 @@
 // Input shaping
 #if ANY(INPUT_SHAPING_X, INPUT_SHAPING_Y)
   #define HAS_ZV_SHAPING 1
+  #ifndef SHAPING_MAX_IMPULSES
+    #define SHAPING_MAX_IMPULSES TERN(__AVR__, 2, 4)
+  #endif
+  #if ENABLED(INPUT_SHAPING_X) && !defined(SHAPING_TYPE_X)
+    #define SHAPING_TYPE_X 0
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y) && !defined(SHAPING_TYPE_Y)
+    #define SHAPING_TYPE_Y 0
+  #endif
 #endif
@@ -255,6 +255,10 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #error "SERIAL_XON_XOFF and SERIAL_STATS_* features not supported on USB-native AVR devices."
 #endif
 
+#if defined(SERIAL_BLOCK_READ) && !WITHIN(SERIAL_BLOCK_READ, 8, 255)
+  #error "SERIAL_BLOCK_READ must be between 8 and 255."
+#endif
+
 /**
  * Multiple Stepper Drivers Per Axis
  */
@@ -984,6 +988,15 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #endif
 #endif
 
+#if ENABLED(MPC_FLOW_LOOKAHEAD)
+  #if DISABLED(MPCTEMP)
+    #error "MPC_FLOW_LOOKAHEAD requires MPCTEMP."
+  #elif !defined(MPC_FLOW_LOOKAHEAD_TIME)
+    #error "MPC_FLOW_LOOKAHEAD requires MPC_FLOW_LOOKAHEAD_TIME."
+  #endif
+  static_assert(MPC_FLOW_LOOKAHEAD_TIME > 0, "MPC_FLOW_LOOKAHEAD_TIME must be greater than 0.");
+#endif
+
 /**
  * Bed Heating Options - PID vs Limit Switching
  */
@@ -1468,8 +1481,16 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
     #error "AUTO_BED_LEVELING_UBL does not yet support SCARA printers."
   #elif DISABLED(EEPROM_SETTINGS)
     #error "AUTO_BED_LEVELING_UBL requires EEPROM_SETTINGS."
-  #elif !WITHIN(GRID_MAX_POINTS_X, 3, 15) || !WITHIN(GRID_MAX_POINTS_Y, 3, 15)
-    #error "GRID_MAX_POINTS_[XY] must be a whole number between 3 and 15."
+  #elif !WITHIN(GRID_MAX_POINTS_X, 3, 31) || !WITHIN(GRID_MAX_POINTS_Y, 3, 31)
+    #error "GRID_MAX_POINTS_[XY] must be a whole number between 3 and 31."
+  #elif ENABLED(COMPRESSED_MESH_STORAGE) && DISABLED(OPTIMIZED_MESH_STORAGE)
+    #error "COMPRESSED_MESH_STORAGE requires OPTIMIZED_MESH_STORAGE."
+  #elif ENABLED(COMPRESSED_MESH_STORAGE) && !WITHIN(COMPRESSED_MESH_SLOT_SIZE, 32, 8192)
+    #error "COMPRESSED_MESH_SLOT_SIZE must be between 32 and 8192."
+  #elif ENABLED(MESH_STORE_SDCARD) && !HAS_MEDIA
+    #error "MESH_STORE_SDCARD requires SDSUPPORT."
+  #elif ENABLED(MESH_STORE_SDCARD) && !WITHIN(MESH_STORE_SD_SLOTS, 1, 100)
+    #error "MESH_STORE_SD_SLOTS must be between 1 and 100."
   #endif
 
 #elif HAS_ABL_NOT_UBL
@@ -1520,6 +1541,10 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #endif
 #endif
 
+#if ENABLED(MESH_CELL_CACHE) && NONE(AUTO_BED_LEVELING_BILINEAR, AUTO_BED_LEVELING_UBL)
+  #error "MESH_CELL_CACHE requires AUTO_BED_LEVELING_BILINEAR or AUTO_BED_LEVELING_UBL."
+#endif
+
 #if ENABLED(G29_RETRY_AND_RECOVER) && NONE(AUTO_BED_LEVELING_3POINT, AUTO_BED_LEVELING_LINEAR, AUTO_BED_LEVELING_BILINEAR)
   #error "G29_RETRY_AND_RECOVER requires AUTO_BED_LEVELING_3POINT, LINEAR, or BILINEAR."
 #endif
@@ -1889,6 +1914,20 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #error "Thermistor 66 requires PREHEAT_TIME_BED_MS ≥ 15000, but 30000 or higher is recommended."
 #endif
 
+/**
+ * Thermistor direct lookup builds its index with C++14 constexpr
+ */
+#if ENABLED(THERMISTOR_DIRECT_LOOKUP) && __cplusplus < 201402L
+  #error "THERMISTOR_DIRECT_LOOKUP requires C++14 (e.g., -std=gnu++14). Disable it for this toolchain."
+#endif
+
+/**
+ * Temperature sensor filters
+ */
+#if ENABLED(TEMP_SENSOR_FILTERS) && !(defined(TEMP_FILTER_HOTEND) && defined(TEMP_FILTER_BED) && defined(TEMP_FILTER_OTHER))
+  #error "TEMP_SENSOR_FILTERS requires TEMP_FILTER_HOTEND, TEMP_FILTER_BED, and TEMP_FILTER_OTHER."
+#endif
+
 /**
  * Required MAX31865 settings
  */
@@ -2487,6 +2526,18 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #endif
 #endif
 
+#if ENABLED(SD_READ_AHEAD) && !WITHIN(SD_READ_AHEAD_BLOCKS, 1, 16)
+  #error "SD_READ_AHEAD_BLOCKS must be between 1 and 16."
+#endif
+
+#if ENABLED(SD_PREPARSED_GCODE) && DISABLED(FASTER_GCODE_PARSER)
+  #error "SD_PREPARSED_GCODE requires FASTER_GCODE_PARSER."
+#endif
+
+#if ENABLED(GCODE_PARSE_ON_ENQUEUE) && DISABLED(FASTER_GCODE_PARSER)
+  #error "GCODE_PARSE_ON_ENQUEUE requires FASTER_GCODE_PARSER."
+#endif
+
 #if ENABLED(SD_IGNORE_AT_STARTUP)
   #if ENABLED(POWER_LOSS_RECOVERY)
     #error "SD_IGNORE_AT_STARTUP is incompatible with POWER_LOSS_RECOVERY."
@@ -3346,8 +3397,10 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
 
 #if !BLOCK_BUFFER_SIZE
   #error "BLOCK_BUFFER_SIZE must be non-zero."
-#elif BLOCK_BUFFER_SIZE > 64
+#elif BLOCK_BUFFER_SIZE > 64 && !defined(CPU_32_BIT)
   #error "A very large BLOCK_BUFFER_SIZE is not needed and takes longer to drain the buffer on pause / cancel."
+#elif BLOCK_BUFFER_SIZE > 1024
+  #error "BLOCK_BUFFER_SIZE must be 1024 or less."
 #endif
 
 #if ENABLED(LED_CONTROL_MENU) && NONE(HAS_MARLINUI_MENU, DWIN_LCD_PROUI)
@@ -3871,6 +3924,7 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
     #else
       static_assert(SHAPING_FREQ_X == SHAPING_FREQ_Y, "SHAPING_FREQ_X and SHAPING_FREQ_Y must be the same for COREXY / COREYX / MARKFORGED_*.");
       static_assert(SHAPING_ZETA_X == SHAPING_ZETA_Y, "SHAPING_ZETA_X and SHAPING_ZETA_Y must be the same for COREXY / COREYX / MARKFORGED_*.");
+      static_assert(SHAPING_TYPE_X == SHAPING_TYPE_Y, "SHAPING_TYPE_X and SHAPING_TYPE_Y must be the same for COREXY / COREYX / MARKFORGED_*.");
     #endif
   #endif
 
@@ -3880,22 +3934,122 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
     TERN_(INPUT_SHAPING_X, static_assert((SHAPING_FREQ_X) > 0, "SHAPING_FREQ_X must be > 0 or SHAPING_MIN_FREQ must be set."));
     TERN_(INPUT_SHAPING_Y, static_assert((SHAPING_FREQ_Y) > 0, "SHAPING_FREQ_Y must be > 0 or SHAPING_MIN_FREQ must be set."));
   #endif
+  #if !WITHIN(SHAPING_MAX_IMPULSES, 2, 4)
+    #error "SHAPING_MAX_IMPULSES must be from 2 to 4."
+  #endif
+
+  // Shaper types 0:ZV (2 impulses), 1:EI (3), 2:2HUMP_EI (4), 3:MZV (3)
+  #define _SHAPING_IMPULSES(T) ((T) == 0 ? 2 : (T) == 2 ? 4 : 3)
+  #define _SHAPING_SPAN(T)     ((T) == 0 ? 0.5 : (T) == 3 ? 0.75 : (T) == 1 ? 1.0 : 1.5)
+  #if ENABLED(INPUT_SHAPING_X)
+    #if !WITHIN(SHAPING_TYPE_X, 0, 3)
+      #error "SHAPING_TYPE_X must be 0 (ZV), 1 (EI), 2 (2HUMP_EI), or 3 (MZV)."
+    #elif _SHAPING_IMPULSES(SHAPING_TYPE_X) > SHAPING_MAX_IMPULSES
+      #error "SHAPING_TYPE_X needs more impulses than SHAPING_MAX_IMPULSES."
+    #endif
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    #if !WITHIN(SHAPING_TYPE_Y, 0, 3)
+      #error "SHAPING_TYPE_Y must be 0 (ZV), 1 (EI), 2 (2HUMP_EI), or 3 (MZV)."
+    #elif _SHAPING_IMPULSES(SHAPING_TYPE_Y) > SHAPING_MAX_IMPULSES
+      #error "SHAPING_TYPE_Y needs more impulses than SHAPING_MAX_IMPULSES."
+    #endif
+  #endif
   #ifdef __AVR__
+    // The longest echo delay has to fit in 16 bits
     #if ENABLED(INPUT_SHAPING_X)
-      #if F_CPU > 16000000
-        static_assert((SHAPING_FREQ_X) == 0 || (SHAPING_FREQ_X) * 2 * 0x10000 >= (STEPPER_TIMER_RATE), "SHAPING_FREQ_X is below the minimum (20) for AVR 20MHz.");
-      #else
-        static_assert((SHAPING_FREQ_X) == 0 || (SHAPING_FREQ_X) * 2 * 0x10000 >= (STEPPER_TIMER_RATE), "SHAPING_FREQ_X is below the minimum (16) for AVR 16MHz.");
-      #endif
+      static_assert((SHAPING_FREQ_X) == 0 || (SHAPING_FREQ_X) * 0x10000 >= (STEPPER_TIMER_RATE) * _SHAPING_SPAN(SHAPING_TYPE_X), "SHAPING_FREQ_X is below the minimum for SHAPING_TYPE_X on AVR (16Hz for ZV at 16MHz).");
     #endif
     #if ENABLED(INPUT_SHAPING_Y)
-      #if F_CPU > 16000000
-        static_assert((SHAPING_FREQ_Y) == 0 || (SHAPING_FREQ_Y) * 2 * 0x10000 >= (STEPPER_TIMER_RATE), "SHAPING_FREQ_Y is below the minimum (20) for AVR 20MHz.");
-      #else
-        static_assert((SHAPING_FREQ_Y) == 0 || (SHAPING_FREQ_Y) * 2 * 0x10000 >= (STEPPER_TIMER_RATE), "SHAPING_FREQ_Y is below the minimum (16) for AVR 16MHz.");
-      #endif
+      static_assert((SHAPING_FREQ_Y) == 0 || (SHAPING_FREQ_Y) * 0x10000 >= (STEPPER_TIMER_RATE) * _SHAPING_SPAN(SHAPING_TYPE_Y), "SHAPING_FREQ_Y is below the minimum for SHAPING_TYPE_Y on AVR (16Hz for ZV at 16MHz).");
     #endif
   #endif
+  #undef _SHAPING_IMPULSES
+  #undef _SHAPING_SPAN
+#endif
+
+/**
+ * Acceleration Ramp Table
+ */
+#if ENABLED(ACCEL_RAMP_TABLE)
+  #if ENABLED(S_CURVE_ACCELERATION)
+    #error "ACCEL_RAMP_TABLE is not compatible with S_CURVE_ACCELERATION."
+  #elif ENABLED(LIN_ADVANCE)
+    #error "ACCEL_RAMP_TABLE is not compatible with LIN_ADVANCE."
+  #elif ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    #error "ACCEL_RAMP_TABLE is not compatible with ADAPTIVE_STEP_SMOOTHING."
+  #endif
+#endif
+
+/**
+ * Multistepping calibration
+ */
+#if ENABLED(CALIBRATE_MULTISTEPPING)
+  #if DISABLED(STEPPER_ISR_PROFILE)
+    #error "CALIBRATE_MULTISTEPPING requires STEPPER_ISR_PROFILE."
+  #endif
+  static_assert(WITHIN(MULTISTEPPING_MARGIN, 0, 400), "MULTISTEPPING_MARGIN must be from 0 to 400.");
+#endif
+
+/**
+ * Resonance Test
+ */
+#if ENABLED(RESONANCE_TEST)
+  #if !HAS_ZV_SHAPING
+    #error "RESONANCE_TEST requires INPUT_SHAPING_X or INPUT_SHAPING_Y."
+  #elif !defined(__PLAT_LINUX__) && !PIN_EXISTS(ADXL345_CS)
+    #error "RESONANCE_TEST requires ADXL345_CS_PIN."
+  #elif (RESONANCE_SAMPLE_RATE) != 3200 && (RESONANCE_SAMPLE_RATE) != 1600 && (RESONANCE_SAMPLE_RATE) != 800 && (RESONANCE_SAMPLE_RATE) != 400
+    #error "RESONANCE_SAMPLE_RATE must be 3200, 1600, 800, or 400."
+  #elif !WITHIN(RESONANCE_MAX_BINS, 2, 255)
+    #error "RESONANCE_MAX_BINS must be from 2 to 255."
+  #endif
+  static_assert(RESONANCE_MIN_FREQ > 0 && RESONANCE_MAX_FREQ >= RESONANCE_MIN_FREQ, "RESONANCE_MIN_FREQ must be > 0 and no more than RESONANCE_MAX_FREQ.");
+  static_assert(RESONANCE_FREQ_STEP > 0, "RESONANCE_FREQ_STEP must be > 0.");
+  static_assert((RESONANCE_MAX_FREQ - RESONANCE_MIN_FREQ) / (RESONANCE_FREQ_STEP) < RESONANCE_MAX_BINS, "RESONANCE_MAX_BINS is too small for the default frequency range.");
+#endif
+
+/**
+ * Arc chord tolerance
+ */
+#if ENABLED(ARC_SUPPORT) && defined(ARC_CHORD_TOLERANCE)
+  #ifndef ARC_CHORD_MAX_SEGMENT_MM
+    #error "ARC_CHORD_TOLERANCE requires ARC_CHORD_MAX_SEGMENT_MM."
+  #endif
+  static_assert(ARC_CHORD_TOLERANCE > 0, "ARC_CHORD_TOLERANCE must be greater than 0.");
+  static_assert(ARC_CHORD_MAX_SEGMENT_MM >= MIN_ARC_SEGMENT_MM, "ARC_CHORD_MAX_SEGMENT_MM must be at least MIN_ARC_SEGMENT_MM.");
+#endif
+
+/**
+ * Merge Collinear Moves
+ */
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #if IS_KINEMATIC
+    #error "MERGE_COLLINEAR_MOVES is not compatible with kinematic machines."
+  #elif ENABLED(LASER_FEATURE)
+    #error "MERGE_COLLINEAR_MOVES is not compatible with LASER_FEATURE."
+  #elif !WITHIN(MERGE_MOVES_MAX_COUNT, 2, 32)
+    #error "MERGE_MOVES_MAX_COUNT must be from 2 to 32."
+  #endif
+  static_assert(MERGE_MOVES_TOLERANCE > 0, "MERGE_MOVES_TOLERANCE must be greater than 0.");
+#endif
+
+/**
+ * Planner Benchmark
+ */
+#if ENABLED(PLANNER_BENCHMARK)
+  #if DISABLED(MARLIN_TEST_BUILD)
+    #error "PLANNER_BENCHMARK requires MARLIN_TEST_BUILD."
+  #elif defined(PLANNER_BENCHMARK_FILE) && !defined(__PLAT_LINUX__) && !defined(__PLAT_NATIVE_SIM__)
+    #error "PLANNER_BENCHMARK_FILE is only supported on native builds."
+  #endif
+#endif
+
+/**
+ * Virtual Time
+ */
+#if ENABLED(VIRTUAL_TIME) && !defined(__PLAT_LINUX__)
+  #error "VIRTUAL_TIME is only supported by the LINUX HAL (linux_native)."
 #endif
 
 // Misc. Cleanup
@@ -74,6 +74,10 @@
   #warning "Your Configuration provides no method to acquire user feedback!"
 #endif
 
+#if ENABLED(SERIAL_WINDOWED_OK) && RX_BUFFER_SIZE && RX_BUFFER_SIZE < (BUFSIZE) * (MAX_CMD_SIZE)
+  #warning "SERIAL_WINDOWED_OK: RX_BUFFER_SIZE can't hold BUFSIZE lines of MAX_CMD_SIZE. Lines in flight may be lost and re-sent."
+#endif
+
 #if MB(DUE3DOM_MINI) && PIN_EXISTS(TEMP_2) && !TEMP_SENSOR_BOARD
   #warning "Onboard temperature sensor for BOARD_DUE3DOM_MINI has moved from TEMP_SENSOR_2 (TEMP_2_PIN) to TEMP_SENSOR_BOARD (TEMP_BOARD_PIN)."
 #elif MB(BTT_SKR_E3_TURBO) && PIN_EXISTS(TEMP_2) && !TEMP_SENSOR_BOARD
@@ -326,6 +326,7 @@ private:
 
           bedlevel.z_values[i][j] = mz - lsf_results.D;
         }
+        bedlevel.refresh_bed_level();
         return false;
       }
 
@@ -3406,7 +3407,7 @@ void CrealityDWINClass::Menu_Item_Handler(const uint8_t menu, const uint8_t item
               Draw_Menu_Item(row, ICON_Back, F("Back"));
             else {
               set_bed_leveling_enabled(level_state);
-              TERN_(AUTO_BED_LEVELING_BILINEAR, bedlevel.refresh_bed_level());
+              IF_DISABLED(MESH_BED_LEVELING, bedlevel.refresh_bed_level());
               Draw_Menu(Leveling, LEVELING_MANUAL);
             }
             break;
@@ -3447,8 +3448,10 @@ void CrealityDWINClass::Menu_Item_Handler(const uint8_t menu, const uint8_t item
               Draw_Float(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y], row, false, 100);
             }
             else {
-              if (isnan(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y]))
+              if (isnan(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y])) {
                 bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] = 0;
+                TERN_(MESH_CELL_CACHE, bedlevel.refresh_bed_level());
+              }
               Modify_Value(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y], MIN_Z_OFFSET, MAX_Z_OFFSET, 100);
             }
             break;
@@ -3457,6 +3460,7 @@ void CrealityDWINClass::Menu_Item_Handler(const uint8_t menu, const uint8_t item
               Draw_Menu_Item(row, ICON_Axis, F("Microstep Up"));
             else if (bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] < MAX_Z_OFFSET) {
               bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] += 0.01;
+              TERN_(MESH_CELL_CACHE, bedlevel.refresh_bed_level());
               gcode.process_subcommands_now(F("M290 Z0.01"));
               planner.synchronize();
               current_position.z += 0.01f;
@@ -3469,6 +3473,7 @@ void CrealityDWINClass::Menu_Item_Handler(const uint8_t menu, const uint8_t item
               Draw_Menu_Item(row, ICON_AxisD, F("Microstep Down"));
             else if (bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] > MIN_Z_OFFSET) {
               bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] -= 0.01;
+              TERN_(MESH_CELL_CACHE, bedlevel.refresh_bed_level());
               gcode.process_subcommands_now(F("M290 Z-0.01"));
               planner.synchronize();
               current_position.z -= 0.01f;
@@ -3568,8 +3573,10 @@ void CrealityDWINClass::Menu_Item_Handler(const uint8_t menu, const uint8_t item
               Draw_Float(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y], row, false, 100);
             }
             else {
-              if (isnan(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y]))
+              if (isnan(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y])) {
                 bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] = 0;
+                TERN_(MESH_CELL_CACHE, bedlevel.refresh_bed_level());
+              }
               Modify_Value(bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y], MIN_Z_OFFSET, MAX_Z_OFFSET, 100);
             }
             break;
@@ -3578,6 +3585,7 @@ void CrealityDWINClass::Menu_Item_Handler(const uint8_t menu, const uint8_t item
               Draw_Menu_Item(row, ICON_Axis, F("Microstep Up"));
             else if (bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] < MAX_Z_OFFSET) {
               bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] += 0.01;
+              TERN_(MESH_CELL_CACHE, bedlevel.refresh_bed_level());
               gcode.process_subcommands_now(F("M290 Z0.01"));
               planner.synchronize();
               current_position.z += 0.01f;
@@ -3590,6 +3598,7 @@ void CrealityDWINClass::Menu_Item_Handler(const uint8_t menu, const uint8_t item
               Draw_Menu_Item(row, ICON_Axis, F("Microstep Down"));
             else if (bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] > MIN_Z_OFFSET) {
               bedlevel.z_values[mesh_conf.mesh_x][mesh_conf.mesh_y] -= 0.01;
+              TERN_(MESH_CELL_CACHE, bedlevel.refresh_bed_level());
               gcode.process_subcommands_now(F("M290 Z-0.01"));
               planner.synchronize();
               current_position.z -= 0.01f;
@@ -4212,6 +4221,11 @@ void CrealityDWINClass::Value_Control() {
       case 4: *(uint32_t*)valuepointer = tempvalue / valueunit; break;
       case 5: *(int8_t*)valuepointer = tempvalue / valueunit; break;
     }
+    #if ENABLED(MESH_CELL_CACHE)
+      // Mesh points are edited in place, so the cell cache must be rebuilt before moving
+      if (WITHIN((float*)valuepointer, &bedlevel.z_values[0][0], &bedlevel.z_values[GRID_MAX_POINTS_X - 1][GRID_MAX_POINTS_Y - 1]))
+        bedlevel.refresh_bed_level();
+    #endif
     switch (active_menu) {
       case Move:
         planner.synchronize();
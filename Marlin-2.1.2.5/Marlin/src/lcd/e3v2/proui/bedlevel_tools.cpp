@@ -133,6 +133,7 @@ char cmd[MAX_CMD_SIZE+16], str_1[16], str_2[16], str_3[16];
 
       bedlevel.z_values[i][j] = mz - lsf_results.D;
     }
+    bedlevel.refresh_bed_level();
     return false;
   }
 
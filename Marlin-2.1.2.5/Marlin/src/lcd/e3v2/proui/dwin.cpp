@@ -3588,7 +3588,10 @@ void Draw_Steps_Menu() {
     void SetEditMeshX() { HMI_value.Select = 0; SetIntOnClick(0, GRID_MAX_POINTS_X - 1, bedLevelTools.mesh_x, ApplyEditMeshX, LiveEditMesh); }
     void ApplyEditMeshY() { bedLevelTools.mesh_y = MenuData.Value; }
     void SetEditMeshY() { HMI_value.Select = 1; SetIntOnClick(0, GRID_MAX_POINTS_Y - 1, bedLevelTools.mesh_y, ApplyEditMeshY, LiveEditMesh); }
-    void SetEditZValue() { SetPFloatOnClick(Z_OFFSET_MIN, Z_OFFSET_MAX, 3); }
+    #if ENABLED(MESH_CELL_CACHE)
+      void ApplyEditMeshZ() { bedlevel.refresh_bed_level(); }
+    #endif
+    void SetEditZValue() { SetPFloatOnClick(Z_OFFSET_MIN, Z_OFFSET_MAX, 3, TERN(MESH_CELL_CACHE, ApplyEditMeshZ, nullptr)); }
   #endif
 
 #endif // HAS_MESH
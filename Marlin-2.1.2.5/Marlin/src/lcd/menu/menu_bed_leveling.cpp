@@ -206,6 +206,7 @@
 #if ENABLED(MESH_EDIT_MENU)
 
   inline void refresh_planner() {
+    TERN_(MESH_CELL_CACHE, bedlevel.refresh_bed_level());
     set_current_from_steppers_for_axis(ALL_AXES_ENUM);
     sync_plan_position();
   }
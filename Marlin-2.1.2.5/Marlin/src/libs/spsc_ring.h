@@ -0,0 +1,132 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Lock-free handoff between one producer and one consumer
+ *
+ * The producer (e.g., the main loop) only writes the head index and the consumer
+ * (e.g., the Stepper ISR or a serial thread) only writes the tail index, so neither
+ * side has to mask the other. The head is stored with release semantics after the
+ * item is filled in and loaded with acquire semantics before the item is read, so
+ * the consumer never sees a slot before its contents. The tail works the same way
+ * in the other direction, so the producer never reuses a slot still being read.
+ */
+
+#include "../core/types.h"
+
+/**
+ * Load an index shared with another context. No later access can be moved before it.
+ * AVR is single core with atomic byte access, so only the compiler has to be held back.
+ */
+template<typename T>
+FORCE_INLINE typename Private::remove_volatile<T>::type load_acquire(const T &ref) {
+  #ifdef __AVR__
+    static_assert(sizeof(T) == 1, "Only single bytes can be shared without locking on AVR.");
+    const typename Private::remove_volatile<T>::type val = *(const volatile T *)&ref;
+    __asm__ __volatile__("" ::: "memory");
+    return val;
+  #else
+    return __atomic_load_n(&ref, __ATOMIC_ACQUIRE);
+  #endif
+}
+
+/**
+ * Store an index shared with another context. No earlier access can be moved after it.
+ */
+template<typename T, typename V>
+FORCE_INLINE void store_release(T &ref, const V val) {
+  #ifdef __AVR__
+    static_assert(sizeof(T) == 1, "Only single bytes can be shared without locking on AVR.");
+    __asm__ __volatile__("" ::: "memory");
+    *(volatile T *)&ref = val;
+  #else
+    __atomic_store_n(&ref, typename Private::remove_volatile<T>::type(val), __ATOMIC_RELEASE);
+  #endif
+}
+
+/**
+ * Single-producer / single-consumer ring buffer
+ *
+ * The indices run freely and wrap with their type, so all N slots can be used
+ * and the fill level is just the difference. N must be a power of 2.
+ *
+ * The producer either calls push() or fills the slot from claim() in place and
+ * then calls publish(). The consumer either calls pop() or reads the slot from
+ * peek() in place and then calls release().
+ */
+template<typename T, uint16_t N>
+class SPSCRing {
+  static_assert(N && !(N & (N - 1)), "SPSCRing size must be a power of 2.");
+
+  public:
+    typedef uvalue_t(N) index_t;
+
+  private:
+    T items[N];
+    index_t head, tail;
+
+    static constexpr index_t mask(const index_t i) { return i & (N - 1); }
+
+  public:
+    SPSCRing() : head(0), tail(0) {}
+
+    // Either side
+    static constexpr index_t size() { return N; }
+    index_t count() const { return index_t(load_acquire(head) - load_acquire(tail)); }
+    bool empty() const { return load_acquire(head) == load_acquire(tail); }
+
+    // Producer side
+    bool full() const { return index_t(head - load_acquire(tail)) >= N; }
+    index_t free() const { return N - index_t(head - load_acquire(tail)); }
+    T* claim() { return full() ? nullptr : &items[mask(head)]; }
+    void publish() { store_release(head, index_t(head + 1)); }
+    bool push(const T &item) {
+      T * const slot = claim();
+      if (!slot) return false;
+      *slot = item;
+      publish();
+      return true;
+    }
+
+    // Consumer side
+    T* peek() { return tail == load_acquire(head) ? nullptr : &items[mask(tail)]; }
+    void release() { store_release(tail, index_t(tail + 1)); }
+    bool pop(T &item) {
+      const T * const slot = peek();
+      if (!slot) return false;
+      item = *slot;
+      release();
+      return true;
+    }
+
+    // Take up to n items at once, releasing them together. Return the number taken.
+    index_t pop(T * const out, const index_t n) {
+      const index_t t = tail, avail = index_t(load_acquire(head) - t), len = _MIN(n, avail);
+      for (index_t i = 0; i < len; ++i) out[i] = items[mask(index_t(t + i))];
+      store_release(tail, index_t(t + len));
+      return len;
+    }
+
+    // Drop everything. Only safe while the producer is idle.
+    void clear() { store_release(tail, load_acquire(head)); }
+};
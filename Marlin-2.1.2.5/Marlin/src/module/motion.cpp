@@ -62,6 +62,10 @@
   #include "../feature/fwretract.h"
 #endif
 
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #include "../feature/move_merge.h"
+#endif
+
 #if ENABLED(BABYSTEP_DISPLAY_TOTAL)
   #include "../feature/babystep.h"
 #endif
@@ -1259,7 +1263,11 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
       }
     #endif // HAS_MESH
 
-    planner.buffer_line(destination, scaled_fr_mm_s);
+    #if ENABLED(MERGE_COLLINEAR_MOVES)
+      move_merge.line_to(current_position, destination, scaled_fr_mm_s);
+    #else
+      planner.buffer_line(destination, scaled_fr_mm_s);
+    #endif
     return false; // caller will update current_position
   }
 
@@ -110,6 +110,10 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #include "../feature/move_merge.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100U
@@ -122,10 +126,13 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
-volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
-                 Planner::block_buffer_nonbusy, // Index of the first non-busy block
-                 Planner::block_buffer_planned, // Index of the optimally planned block
-                 Planner::block_buffer_tail;    // Index of the busy block, if any
+#if ENABLED(PLANNER_SPLIT_BLOCK)
+  block_plan_t Planner::block_plan[BLOCK_BUFFER_SIZE];
+#endif
+volatile block_index_t Planner::block_buffer_head,    // Index of the next block to be pushed
+                       Planner::block_buffer_nonbusy, // Index of the first non-busy block
+                       Planner::block_buffer_planned, // Index of the optimally planned block
+                       Planner::block_buffer_tail;    // Index of the busy block, if any
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // Delay block delivery so initial blocks in an empty queue may merge
 
@@ -241,7 +248,8 @@ float Planner::previous_nominal_speed;
 #endif
 
 #if HAS_WIRED_LCD
-  volatile uint32_t Planner::block_buffer_runtime_us = 0;
+  uint32_t Planner::block_buffer_runtime_us = 0;
+  volatile uint32_t Planner::block_buffer_runtime_taken_us = 0;
 #endif
 
 /**
@@ -735,7 +743,7 @@ void Planner::init() {
  */
 block_t* Planner::get_current_block() {
   // Get the number of moves in the planner queue so far
-  const uint8_t nr_moves = movesplanned();
+  const block_index_t nr_moves = movesplanned();
 
   // If there are any moves queued ...
   if (nr_moves) {
@@ -753,28 +761,32 @@ block_t* Planner::get_current_block() {
     block_t * const block = &block_buffer[block_buffer_tail];
 
     // No trapezoid calculated? Don't execute yet.
-    if (block->flag.recalculate) return nullptr;
+    if (plan_of(block).flag.recalculate) return nullptr;
 
     // We can't be sure how long an active block will take, so don't count it.
-    TERN_(HAS_WIRED_LCD, block_buffer_runtime_us -= block->segment_time_us);
+    TERN_(HAS_WIRED_LCD, block_buffer_runtime_taken_us += block->segment_time_us);
 
     // As this block is busy, advance the nonbusy block pointer
-    block_buffer_nonbusy = next_block_index(block_buffer_tail);
+    const block_index_t nonbusy = next_block_index(block_buffer_tail);
+    store_release(block_buffer_nonbusy, nonbusy);
 
     // Push block_buffer_planned pointer, if encountered.
-    if (block_buffer_tail == block_buffer_planned)
-      block_buffer_planned = block_buffer_nonbusy;
+    if (block_buffer_tail == load_acquire(block_buffer_planned))
+      store_release(block_buffer_planned, nonbusy);
 
     // Return the block
     return block;
   }
 
-  // The queue became empty
-  TERN_(HAS_WIRED_LCD, clear_block_buffer_runtime()); // paranoia. Buffer is empty now - so reset accumulated time to zero.
-
   return nullptr;
 }
 
+// Step rate for a fraction of the nominal rate (steps per second)
+FORCE_INLINE static uint32_t trapezoid_step_rate(const block_t * const block, const_float_t factor) {
+  // Limit minimal step rate (Otherwise the timer will overflow.)
+  return _MAX(uint32_t(CEIL(block->nominal_rate * factor)), uint32_t(MINIMAL_STEP_RATE));
+}
+
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
  * by the provided factors.
@@ -787,12 +799,8 @@ block_t* Planner::get_current_block() {
  */
 void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t entry_factor, const_float_t exit_factor) {
 
-  uint32_t initial_rate = CEIL(block->nominal_rate * entry_factor),
-           final_rate = CEIL(block->nominal_rate * exit_factor); // (steps per second)
-
-  // Limit minimal step rate (Otherwise the timer will overflow.)
-  NOLESS(initial_rate, uint32_t(MINIMAL_STEP_RATE));
-  NOLESS(final_rate, uint32_t(MINIMAL_STEP_RATE));
+  const uint32_t initial_rate = trapezoid_step_rate(block, entry_factor),
+                 final_rate = trapezoid_step_rate(block, exit_factor);
 
   #if ANY(S_CURVE_ACCELERATION, LIN_ADVANCE)
     // If we have some plateau time, the cruise rate will be the nominal rate
@@ -849,6 +857,11 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
   block->accelerate_until = accelerate_steps;
   block->decelerate_after = block->step_event_count - decelerate_steps;
   block->initial_rate = initial_rate;
+  #if ENABLED(ACCEL_RAMP_TABLE)
+    // Start the block where the ramp reaches the initial rate
+    if (block->ramp_scale)
+      stepper.ramp_locate(0.5f * (RAMP_UNITS_PER_STEP) * sq(float(initial_rate)) * inverse_accel, block->ramp_seg, block->ramp_frac);
+  #endif
   #if ENABLED(S_CURVE_ACCELERATION)
     block->acceleration_time = acceleration_time;
     block->deceleration_time = deceleration_time;
@@ -988,19 +1001,21 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
  */
 
 // The kernel called by recalculate() when scanning the plan from last to first entry.
-void Planner::reverse_pass_kernel(block_t * const current, const block_t * const next
+// Return 'true' if the entry speed of the block was changed.
+bool Planner::reverse_pass_kernel(block_t * const current, const block_t * const next
   OPTARG(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)
 ) {
   if (current) {
+    block_plan_t &cur = plan_of(current);
     // If entry speed is already at the maximum entry speed, and there was no change of speed
     // in the next block, there is no need to recheck. Block is cruising and there is no need to
     // compute anything for this block,
     // If not, block entry speed needs to be recalculated to ensure maximum possible planned speed.
-    const float max_entry_speed_sqr = current->max_entry_speed_sqr;
+    const float max_entry_speed_sqr = cur.max_entry_speed_sqr;
 
     // Compute maximum entry speed decelerating over the current block from its exit speed.
     // If not at the maximum entry speed, or the previous block entry speed changed
-    if (current->entry_speed_sqr != max_entry_speed_sqr || (next && next->flag.recalculate)) {
+    if (cur.entry_speed_sqr != max_entry_speed_sqr || (next && plan_of(next).flag.recalculate)) {
 
       // If nominal length true, max junction speed is guaranteed to be reached.
       // If a block can de/ac-celerate from nominal speed to zero within the length of the block, then
@@ -1010,15 +1025,15 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
       // the reverse and forward planners, the corresponding block junction speed will always be at the
       // the maximum junction speed and may always be ignored for any speed reduction checks.
 
-      const float next_entry_speed_sqr = next ? next->entry_speed_sqr : _MAX(TERN0(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr), sq(float(MINIMUM_PLANNER_SPEED))),
-                  new_entry_speed_sqr = current->flag.nominal_length
+      const float next_entry_speed_sqr = next ? plan_of(next).entry_speed_sqr : _MAX(TERN0(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr), sq(float(MINIMUM_PLANNER_SPEED))),
+                  new_entry_speed_sqr = cur.flag.nominal_length
                     ? max_entry_speed_sqr
-                    : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-current->acceleration, next_entry_speed_sqr, current->millimeters));
-      if (current->entry_speed_sqr != new_entry_speed_sqr) {
+                    : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-cur.acceleration, next_entry_speed_sqr, cur.millimeters));
+      if (cur.entry_speed_sqr != new_entry_speed_sqr) {
 
         // Need to recalculate the block speed - Mark it now, so the stepper
         // ISR does not consume the block before being recalculated
-        current->flag.recalculate = true;
+        cur.flag.recalculate = true;
 
         // But there is an inherent race condition here, as the block may have
         // become BUSY just before being marked RECALCULATE, so check for that!
@@ -1026,16 +1041,18 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
           // Block became busy. Clear the RECALCULATE flag (no point in
           // recalculating BUSY blocks). And don't set its speed, as it can't
           // be updated at this time.
-          current->flag.recalculate = false;
+          cur.flag.recalculate = false;
         }
         else {
           // Block is not BUSY so this is ahead of the Stepper ISR:
           // Just Set the new entry speed.
-          current->entry_speed_sqr = new_entry_speed_sqr;
+          cur.entry_speed_sqr = new_entry_speed_sqr;
+          return true;
         }
       }
     }
   }
+  return false;
 }
 
 /**
@@ -1044,11 +1061,11 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
  */
 void Planner::reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)) {
   // Initialize block index to the last block in the planner buffer.
-  uint8_t block_index = prev_block_index(block_buffer_head);
+  block_index_t block_index = prev_block_index(block_buffer_head);
 
   // Read the index of the last buffer planned block.
   // The ISR may change it so get a stable local copy.
-  uint8_t planned_block_index = block_buffer_planned;
+  block_index_t planned_block_index = load_acquire(block_buffer_planned);
 
   // If there was a race condition and block_buffer_planned was incremented
   //  or was pointing at the head (queue empty) break loop now and avoid
@@ -1065,8 +1082,14 @@ void Planner::reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_
     block_t *current = &block_buffer[block_index];
 
     // Only process movement blocks
-    if (current->is_move()) {
-      reverse_pass_kernel(current, next OPTARG(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr));
+    if (plan_of(current).is_move()) {
+      #if ENABLED(PLANNER_INCREMENTAL_RECALC)
+        // Older blocks were planned against this same entry speed, so if it didn't
+        // change they can't either. The newest block is new to its predecessor.
+        if (!reverse_pass_kernel(current, next OPTARG(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr)) && next) return;
+      #else
+        reverse_pass_kernel(current, next OPTARG(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr));
+      #endif
       next = current;
     }
 
@@ -1076,7 +1099,7 @@ void Planner::reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_
     // The ISR could advance the block_buffer_planned while we were doing the reverse pass.
     // We must try to avoid using an already consumed block as the last one - So follow
     // changes to the pointer and make sure to limit the loop to the currently busy block
-    while (planned_block_index != block_buffer_planned) {
+    while (planned_block_index != load_acquire(block_buffer_planned)) {
 
       // If we reached the busy block or an already processed block, break the loop now
       if (block_index == planned_block_index) return;
@@ -1088,23 +1111,25 @@ void Planner::reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
-void Planner::forward_pass_kernel(const block_t * const previous, block_t * const current, const uint8_t block_index) {
+void Planner::forward_pass_kernel(const block_t * const previous, block_t * const current, const block_index_t block_index) {
   if (previous) {
+    const block_plan_t &prev = plan_of(previous);
+    block_plan_t &cur = plan_of(current);
     // If the previous block is an acceleration block, too short to complete the full speed
     // change, adjust the entry speed accordingly. Entry speeds have already been reset,
     // maximized, and reverse-planned. If nominal length is set, max junction speed is
     // guaranteed to be reached. No need to recheck.
-    if (!previous->flag.nominal_length && previous->entry_speed_sqr < current->entry_speed_sqr) {
+    if (!prev.flag.nominal_length && prev.entry_speed_sqr < cur.entry_speed_sqr) {
 
       // Compute the maximum allowable speed
-      const float new_entry_speed_sqr = max_allowable_speed_sqr(-previous->acceleration, previous->entry_speed_sqr, previous->millimeters);
+      const float new_entry_speed_sqr = max_allowable_speed_sqr(-prev.acceleration, prev.entry_speed_sqr, prev.millimeters);
 
       // If true, current block is full-acceleration and we can move the planned pointer forward.
-      if (new_entry_speed_sqr < current->entry_speed_sqr) {
+      if (new_entry_speed_sqr < cur.entry_speed_sqr) {
 
         // Mark we need to recompute the trapezoidal shape, and do it now,
         // so the stepper ISR does not consume the block before being recalculated
-        current->flag.recalculate = true;
+        cur.flag.recalculate = true;
 
         // But there is an inherent race condition here, as the block maybe
         // became BUSY, just before it was marked as RECALCULATE, so check
@@ -1113,16 +1138,16 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
           // Block became busy. Clear the RECALCULATE flag (no point in
           //  recalculating BUSY blocks and don't set its speed, as it can't
           //  be updated at this time.
-          current->flag.recalculate = false;
+          cur.flag.recalculate = false;
         }
         else {
           // Block is not BUSY, we won the race against the Stepper ISR:
 
           // Always <= max_entry_speed_sqr. Backward pass sets this.
-          current->entry_speed_sqr = new_entry_speed_sqr; // Always <= max_entry_speed_sqr. Backward pass sets this.
+          cur.entry_speed_sqr = new_entry_speed_sqr; // Always <= max_entry_speed_sqr. Backward pass sets this.
 
           // Set optimal plan pointer.
-          block_buffer_planned = block_index;
+          store_release(block_buffer_planned, block_index);
         }
       }
     }
@@ -1131,8 +1156,8 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
     // point in the buffer. When the plan is bracketed by either the beginning of the
     // buffer and a maximum entry speed or two maximum entry speeds, every block in between
     // cannot logically be further improved. Hence, we don't have to recompute them anymore.
-    if (current->entry_speed_sqr == current->max_entry_speed_sqr)
-      block_buffer_planned = block_index;
+    if (cur.entry_speed_sqr == cur.max_entry_speed_sqr)
+      store_release(block_buffer_planned, block_index);
   }
 }
 
@@ -1149,7 +1174,7 @@ void Planner::forward_pass() {
   //  by the stepper ISR,  so read it ONCE. It it guaranteed that block_buffer_planned
   //  will never lead head, so the loop is safe to execute. Also note that the forward
   //  pass will never modify the values at the tail.
-  uint8_t block_index = block_buffer_planned;
+  block_index_t block_index = load_acquire(block_buffer_planned);
 
   block_t *block;
   const block_t * previous = nullptr;
@@ -1159,7 +1184,7 @@ void Planner::forward_pass() {
     block = &block_buffer[block_index];
 
     // Only process movement blocks
-    if (block->is_move()) {
+    if (plan_of(block).is_move()) {
       // If there's no previous block or the previous block is not
       // BUSY (thus, modifiable) run the forward_pass_kernel. Otherwise,
       // the previous block became BUSY, so assume the current block's
@@ -1175,27 +1200,26 @@ void Planner::forward_pass() {
 }
 
 /**
- * Recalculate the trapezoid speed profiles for all blocks in the plan
- * according to the entry_factor for each junction. Must be called by
- * recalculate() after updating the blocks.
+ * Recalculate the trapezoid speed profiles for all blocks in the plan, starting
+ * from first_block_index, according to the entry_factor for each junction.
+ * Must be called by recalculate() after updating the blocks.
  */
-void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)) {
-  // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
-          head_block_index = block_buffer_head;
+void Planner::recalculate_trapezoids(const block_index_t first_block_index OPTARG(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)) {
+  block_index_t block_index = first_block_index,
+                head_block_index = block_buffer_head;
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
   while (head_block_index != block_index) {
 
     // Go back (head always point to the first free block)
-    const uint8_t prev_index = prev_block_index(head_block_index);
+    const block_index_t prev_index = prev_block_index(head_block_index);
 
     // Get the pointer to the block
     block_t *prev = &block_buffer[prev_index];
 
     // It the block is a move, we're done with this loop
-    if (prev->is_move()) break;
+    if (plan_of(prev).is_move()) break;
 
     // Examine the previous block. This and all following are SYNC blocks
     head_block_index = prev_index;
@@ -1209,16 +1233,16 @@ void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t
     next = &block_buffer[block_index];
 
     // Only process movement blocks
-    if (next->is_move()) {
-      next_entry_speed = SQRT(next->entry_speed_sqr);
+    if (plan_of(next).is_move()) {
+      next_entry_speed = SQRT(plan_of(next).entry_speed_sqr);
 
       if (block) {
 
         // If the next block is marked to RECALCULATE, also mark the previously-fetched one
-        if (next->flag.recalculate) block->flag.recalculate = true;
+        if (plan_of(next).flag.recalculate) plan_of(block).flag.recalculate = true;
 
         // Recalculate if current block entry or exit junction speed has changed.
-        if (block->flag.recalculate) {
+        if (plan_of(block).flag.recalculate) {
 
           // But there is an inherent race condition here, as the block maybe
           // became BUSY, just before it was marked as RECALCULATE, so check
@@ -1227,13 +1251,19 @@ void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t
             // Block is not BUSY, we won the race against the Stepper ISR:
 
             // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-            const float nomr = 1.0f / block->nominal_speed;
-            calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
+            const float nomr = 1.0f / plan_of(block).nominal_speed;
+            #if ENABLED(PLANNER_INCREMENTAL_RECALC)
+              // The trapezoid only depends on the initial and final rates, so skip it if they're the same
+              if (trapezoid_step_rate(block, current_entry_speed * nomr) != block->initial_rate
+                || trapezoid_step_rate(block, next_entry_speed * nomr) != block->final_rate
+              )
+            #endif
+                calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
           }
 
           // Reset current only to ensure next trapezoid is computed - The
           // stepper is free to use the block from now on.
-          block->flag.recalculate = false;
+          plan_of(block).flag.recalculate = false;
         }
       }
 
@@ -1252,7 +1282,7 @@ void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t
     // Mark the next(last) block as RECALCULATE, to prevent the Stepper ISR running it.
     // As the last block is always recalculated here, there is a chance the block isn't
     // marked as RECALCULATE yet. That's the reason for the following line.
-    block->flag.recalculate = true;
+    plan_of(block).flag.recalculate = true;
 
     // But there is an inherent race condition here, as the block maybe
     // became BUSY, just before it was marked as RECALCULATE, so check
@@ -1260,25 +1290,28 @@ void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t
     if (!stepper.is_block_busy(block)) {
       // Block is not BUSY, we won the race against the Stepper ISR:
 
-      const float nomr = 1.0f / block->nominal_speed;
+      const float nomr = 1.0f / plan_of(block).nominal_speed;
       calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
     }
 
     // Reset block to ensure its trapezoid is computed - The stepper is free to use
     // the block from now on.
-    block->flag.recalculate = false;
+    plan_of(block).flag.recalculate = false;
   }
 }
 
 void Planner::recalculate(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)) {
+  // The passes only change blocks after the optimally planned block, so the trapezoids
+  // can be updated from there. Otherwise start from the tail, which the ISR may change.
+  const block_index_t first_block_index = load_acquire(TERN(PLANNER_INCREMENTAL_RECALC, block_buffer_planned, block_buffer_tail));
   // Initialize block index to the last block in the planner buffer.
-  const uint8_t block_index = prev_block_index(block_buffer_head);
+  const block_index_t block_index = prev_block_index(block_buffer_head);
   // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
+  if (block_index != load_acquire(block_buffer_planned)) {
     reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr));
     forward_pass();
   }
-  recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr));
+  recalculate_trapezoids(first_block_index OPTARG(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr));
 }
 
 /**
@@ -1349,7 +1382,7 @@ void Planner::check_axes_activity() {
   if (has_blocks_queued()) {
 
     #if ANY(HAS_TAIL_FAN_SPEED, BARICUDA)
-      block_t *block = &block_buffer[block_buffer_tail];
+      block_t *block = &block_buffer[load_acquire(block_buffer_tail)];
     #endif
 
     #if HAS_TAIL_FAN_SPEED
@@ -1368,7 +1401,7 @@ void Planner::check_axes_activity() {
     #endif
 
     #if HAS_DISABLE_AXES
-      for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+      for (block_index_t b = load_acquire(block_buffer_tail); b != block_buffer_head; b = next_block_index(b)) {
         block_t * const bnext = &block_buffer[b];
         LOGICAL_AXIS_CODE(
           if (TERN0(DISABLE_E, bnext->steps.e)) axis_active.e = true,
@@ -1486,10 +1519,10 @@ void Planner::check_axes_activity() {
     if (thermalManager.degTargetHotend(active_extruder) < autotemp_min - 2) return; // Below the min?
 
     float high = 0.0f;
-    for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+    for (block_index_t b = load_acquire(block_buffer_tail); b != block_buffer_head; b = next_block_index(b)) {
       const block_t * const block = &block_buffer[b];
       if (NUM_AXIS_GANG(block->steps.x, || block->steps.y, || block->steps.z, || block->steps.i, || block->steps.j, || block->steps.k, || block->steps.u, || block->steps.v, || block->steps.w)) {
-        const float se = float(block->steps.e) / block->step_event_count * block->nominal_speed; // mm/sec
+        const float se = float(block->steps.e) / block->step_event_count * plan_of(block).nominal_speed; // mm/sec
         NOLESS(high, se);
       }
     }
@@ -1686,6 +1719,7 @@ void Planner::quick_stop() {
   const bool was_enabled = stepper.suspend();
 
   // Drop all queue entries
+  TERN_(MERGE_COLLINEAR_MOVES, move_merge.discard());
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
   // Restart the block delay for the first movement - As the queue was
@@ -1740,6 +1774,7 @@ bool Planner::busy() {
 }
 
 void Planner::finish_and_disable() {
+  TERN_(MERGE_COLLINEAR_MOVES, move_merge.flush());
   while (has_blocks_queued() || cleaning_buffer_counter) idle();
   stepper.disable_all_steppers();
 }
@@ -1800,7 +1835,10 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 /**
  * Block until the planner is finished processing
  */
-void Planner::synchronize() { while (busy()) idle(); }
+void Planner::synchronize() {
+  TERN_(MERGE_COLLINEAR_MOVES, move_merge.flush());
+  while (busy()) idle();
+}
 
 /**
  * @brief Add a new linear movement to the planner queue (in terms of steps).
@@ -1821,7 +1859,7 @@ bool Planner::_buffer_steps(const xyze_long_t &target
 ) {
 
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
   // If we are cleaning, do not accept queuing of movements
@@ -1849,10 +1887,15 @@ bool Planner::_buffer_steps(const xyze_long_t &target
     // variable, so there is no risk setting this here (but it MUST be done
     // before the following line!!)
     delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
+    // Start the runtime totals over, so no drift outlasts an empty queue
+    TERN_(HAS_WIRED_LCD, clear_block_buffer_runtime());
   }
 
-  // Move buffer head
-  block_buffer_head = next_buffer_head;
+  // Count the block runtime before the ISR can take it
+  TERN_(HAS_WIRED_LCD, block_buffer_runtime_us += block->segment_time_us);
+
+  // Move buffer head, publishing the finished block to the Stepper ISR
+  store_release(block_buffer_head, next_buffer_head);
 
   // Recalculate and optimize trapezoidal speed profiles
   recalculate(TERN_(HINTS_SAFE_EXIT_SPEED, hints.safe_exit_speed_sqr));
@@ -1884,6 +1927,8 @@ bool Planner::_populate_block(
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , feedRate_t fr_mm_s, const uint8_t extruder, const PlannerHints &hints
 ) {
+  block_plan_t &plan = plan_of(block);
+
   int32_t LOGICAL_AXIS_LIST(
     de = target.e - position.e,
     da = target.a - position.a,
@@ -2018,7 +2063,7 @@ bool Planner::_populate_block(
   #endif
 
   // Clear all flags, including the "busy" bit
-  block->flag.clear();
+  plan.flag.clear();
 
   // Set direction bits
   block->direction_bits = dm;
@@ -2145,11 +2190,11 @@ bool Planner::_populate_block(
       && block->steps.u < MIN_STEPS_PER_SEGMENT, && block->steps.v < MIN_STEPS_PER_SEGMENT, && block->steps.w < MIN_STEPS_PER_SEGMENT
     )
   ) {
-    block->millimeters = TERN0(HAS_EXTRUDERS, ABS(steps_dist_mm.e));
+    plan.millimeters = TERN0(HAS_EXTRUDERS, ABS(steps_dist_mm.e));
   }
   else {
     if (hints.millimeters)
-      block->millimeters = hints.millimeters;
+      plan.millimeters = hints.millimeters;
     else {
       /**
        * Distance for interpretation of feedrate in accordance with LinuxCNC (the successor of NIST
@@ -2215,7 +2260,7 @@ bool Planner::_populate_block(
         }
       #endif
 
-      block->millimeters = SQRT(distance_sqr);
+      plan.millimeters = SQRT(distance_sqr);
     }
 
     /**
@@ -2351,7 +2396,7 @@ bool Planner::_populate_block(
   else
     NOLESS(fr_mm_s, settings.min_travel_feedrate_mm_s);
 
-  const float inverse_millimeters = 1.0f / block->millimeters;  // Inverse millimeters to remove multiple divides
+  const float inverse_millimeters = 1.0f / plan.millimeters;  // Inverse millimeters to remove multiple divides
 
   // Calculate inverse time for this move. No divide by zero due to previous checks.
   // Example: At 120mm/s a 60mm move involving XYZ axes takes 0.5s. So this will give 2.0.
@@ -2365,10 +2410,10 @@ bool Planner::_populate_block(
   );
 
   // Get the number of non busy movements in queue (non busy means that they can be altered)
-  const uint8_t moves_queued = nonbusy_movesplanned();
+  const block_index_t moves_queued = nonbusy_movesplanned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
-  #if ANY(SLOWDOWN, HAS_WIRED_LCD) || defined(XY_FREQUENCY_LIMIT)
+  #if ANY(SLOWDOWN, HAS_WIRED_LCD, MPC_FLOW_LOOKAHEAD) || defined(XY_FREQUENCY_LIMIT)
     // Segment time in microseconds
     int32_t segment_time_us = LROUND(1000000.0f / inverse_secs);
   #endif
@@ -2383,24 +2428,18 @@ bool Planner::_populate_block(
         // Buffer is draining so add extra time. The amount of time added increases if the buffer is still emptied more.
         const int32_t nst = segment_time_us + LROUND(2 * time_diff / moves_queued);
         inverse_secs = 1000000.0f / nst;
-        #if defined(XY_FREQUENCY_LIMIT) || HAS_WIRED_LCD
+        #if defined(XY_FREQUENCY_LIMIT) || ANY(HAS_WIRED_LCD, MPC_FLOW_LOOKAHEAD)
           segment_time_us = nst;
         #endif
       }
     }
   #endif
 
-  #if HAS_WIRED_LCD
-    // Protect the access to the position.
-    const bool was_enabled = stepper.suspend();
-
-    block_buffer_runtime_us += segment_time_us;
-    block->segment_time_us = segment_time_us;
-
-    if (was_enabled) stepper.wake_up();
+  #if ANY(HAS_WIRED_LCD, MPC_FLOW_LOOKAHEAD)
+    block->segment_time_us = segment_time_us;   // Lengthened below if the speed is limited
   #endif
 
-  block->nominal_speed = block->millimeters * inverse_secs;           // (mm/sec) Always > 0
+  plan.nominal_speed = plan.millimeters * inverse_secs;           // (mm/sec) Always > 0
   block->nominal_rate = CEIL(block->step_event_count * inverse_secs); // (step/sec) Always > 0
 
   #if ENABLED(FILAMENT_WIDTH_SENSOR)
@@ -2496,7 +2535,10 @@ bool Planner::_populate_block(
   if (speed_factor < 1.0f) {
     current_speed *= speed_factor;
     block->nominal_rate *= speed_factor;
-    block->nominal_speed *= speed_factor;
+    plan.nominal_speed *= speed_factor;
+    #if ANY(HAS_WIRED_LCD, MPC_FLOW_LOOKAHEAD)
+      block->segment_time_us = LROUND(float(block->segment_time_us) / speed_factor);
+    #endif
   }
 
   // Compute and limit the acceleration rate for the trapezoid generator.
@@ -2547,7 +2589,7 @@ bool Planner::_populate_block(
 
       if (use_advance_lead) {
         float e_D_ratio = (target_float.e - position_float.e) /
-          TERN(IS_KINEMATIC, block->millimeters,
+          TERN(IS_KINEMATIC, plan.millimeters,
             SQRT(sq(target_float.x - position_float.x)
                + sq(target_float.y - position_float.y)
                + sq(target_float.z - position_float.z))
@@ -2587,10 +2629,14 @@ bool Planner::_populate_block(
     }
   }
   block->acceleration_steps_per_s2 = accel;
-  block->acceleration = accel / steps_per_mm;
+  plan.acceleration = accel / steps_per_mm;
   #if DISABLED(S_CURVE_ACCELERATION)
     block->acceleration_rate = (uint32_t)(accel * (float(1UL << 24) / (STEPPER_TIMER_RATE)));
   #endif
+  #if ENABLED(ACCEL_RAMP_TABLE)
+    // Timer ticks per step one unit up the ramp, where the rate is sqrt(2 * accel / units per step)
+    block->ramp_scale = accel ? uint32_t((STEPPER_TIMER_RATE) * SQRT(0.5f * (RAMP_UNITS_PER_STEP) / accel)) : 0;
+  #endif
 
   #if ENABLED(LIN_ADVANCE)
     block->la_advance_rate = 0;
@@ -2701,7 +2747,7 @@ bool Planner::_populate_block(
         xyze_float_t junction_unit_vec = unit_vec - prev_unit_vec;
         normalize_junction_vector(junction_unit_vec);
 
-        const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec);
+        const float junction_acceleration = limit_value_by_axis_maximum(plan.acceleration, junction_unit_vec);
 
         if (TERN0(HINTS_CURVE_RADIUS, hints.curve_radius)) {
           TERN_(HINTS_CURVE_RADIUS, vmax_junction_sqr = junction_acceleration * hints.curve_radius);
@@ -2716,7 +2762,7 @@ bool Planner::_populate_block(
           #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
 
             // For small moves with >135° junction (octagon) find speed for approximate arc
-            if (block->millimeters < 1 && junction_cos_theta < -0.7071067812f) {
+            if (plan.millimeters < 1 && junction_cos_theta < -0.7071067812f) {
 
               #if ENABLED(JD_USE_MATH_ACOS)
 
@@ -2795,7 +2841,7 @@ bool Planner::_populate_block(
 
               #endif
 
-              const float limit_sqr = (block->millimeters * junction_acceleration) / junction_theta;
+              const float limit_sqr = (plan.millimeters * junction_acceleration) / junction_theta;
               NOMORE(vmax_junction_sqr, limit_sqr);
             }
 
@@ -2804,7 +2850,7 @@ bool Planner::_populate_block(
       }
 
       // Get the lowest speed
-      vmax_junction_sqr = _MIN(vmax_junction_sqr, sq(block->nominal_speed), sq(previous_nominal_speed));
+      vmax_junction_sqr = _MIN(vmax_junction_sqr, sq(plan.nominal_speed), sq(previous_nominal_speed));
     }
     else // Init entry speed to zero. Assume it starts from rest. Planner will correct this later.
       vmax_junction_sqr = 0;
@@ -2823,7 +2869,7 @@ bool Planner::_populate_block(
     static float previous_safe_speed;
 
     // Start with a safe speed (from which the machine may halt to stop immediately).
-    float safe_speed = block->nominal_speed;
+    float safe_speed = plan.nominal_speed;
 
     #ifndef TRAVEL_EXTRA_XYJERK
       #define TRAVEL_EXTRA_XYJERK 0
@@ -2836,7 +2882,7 @@ bool Planner::_populate_block(
                   maxj = (max_jerk[i] + (i == X_AXIS || i == Y_AXIS ? extra_xyjerk : 0.0f)); // mj : The max jerk setting for this axis
       if (jerk > maxj) {                          // cs > mj : New current speed too fast?
         if (limited) {                            // limited already?
-          const float mjerk = block->nominal_speed * maxj; // ns*mj
+          const float mjerk = plan.nominal_speed * maxj; // ns*mj
           if (jerk * safe_speed > mjerk) safe_speed = mjerk / jerk; // ns*mj/cs
         }
         else {
@@ -2859,8 +2905,8 @@ bool Planner::_populate_block(
       // The junction velocity will be shared between successive segments. Limit the junction velocity to their minimum.
       // Pick the smaller of the nominal speeds. Higher speed shall not be achieved at the junction during coasting.
       float smaller_speed_factor = 1.0f;
-      if (block->nominal_speed < previous_nominal_speed) {
-        vmax_junction = block->nominal_speed;
+      if (plan.nominal_speed < previous_nominal_speed) {
+        vmax_junction = plan.nominal_speed;
         smaller_speed_factor = vmax_junction / previous_nominal_speed;
       }
       else
@@ -2911,13 +2957,13 @@ bool Planner::_populate_block(
   #endif // Classic Jerk Limiting
 
   // Max entry speed of this block equals the max exit speed of the previous block.
-  block->max_entry_speed_sqr = vmax_junction_sqr;
+  plan.max_entry_speed_sqr = vmax_junction_sqr;
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
-  const float v_allowable_sqr = max_allowable_speed_sqr(-block->acceleration, sq(float(MINIMUM_PLANNER_SPEED)), block->millimeters);
+  const float v_allowable_sqr = max_allowable_speed_sqr(-plan.acceleration, sq(float(MINIMUM_PLANNER_SPEED)), plan.millimeters);
 
   // Start with the minimum allowed speed
-  block->entry_speed_sqr = sq(float(MINIMUM_PLANNER_SPEED));
+  plan.entry_speed_sqr = sq(float(MINIMUM_PLANNER_SPEED));
 
   // Initialize planner efficiency flags
   // Set flag if block will always reach maximum junction speed regardless of entry/exit speeds.
@@ -2927,11 +2973,11 @@ bool Planner::_populate_block(
   // block nominal speed limits both the current and next maximum junction speeds. Hence, in both
   // the reverse and forward planners, the corresponding block junction speed will always be at the
   // the maximum junction speed and may always be ignored for any speed reduction checks.
-  block->flag.set_nominal(sq(block->nominal_speed) <= v_allowable_sqr);
+  plan.flag.set_nominal(sq(plan.nominal_speed) <= v_allowable_sqr);
 
   // Update previous path unit_vector and nominal speed
   previous_speed = current_speed;
-  previous_nominal_speed = block->nominal_speed;
+  previous_nominal_speed = plan.nominal_speed;
 
   position = target;  // Update the position
 
@@ -2955,13 +3001,17 @@ bool Planner::_populate_block(
  */
 void Planner::buffer_sync_block(const BlockFlagBit sync_flag/*=BLOCK_BIT_SYNC_POSITION*/) {
 
+  // A held move must come first
+  TERN_(MERGE_COLLINEAR_MOVES, move_merge.flush());
+
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
   // Clear block
   block->reset();
-  block->flag.apply(sync_flag);
+  TERN_(PLANNER_SPLIT_BLOCK, plan_of(block).reset());
+  plan_of(block).flag.apply(sync_flag);
 
   block->position = position;
   #if ENABLED(BACKLASH_COMPENSATION)
@@ -2987,7 +3037,7 @@ void Planner::buffer_sync_block(const BlockFlagBit sync_flag/*=BLOCK_BIT_SYNC_PO
     delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
   }
 
-  block_buffer_head = next_buffer_head;
+  store_release(block_buffer_head, next_buffer_head);
 
   stepper.wake_up();
 } // buffer_sync_block()
@@ -3016,6 +3066,9 @@ bool Planner::buffer_segment(const abce_pos_t &abce
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_counter) return false;
 
+  // A held move must come first
+  TERN_(MERGE_COLLINEAR_MOVES, move_merge.flush());
+
   // When changing extruders recalculate steps corresponding to the E position
   #if ENABLED(DISTINCT_E_FACTORS)
     if (last_extruder != extruder && settings.axis_steps_per_mm[E_AXIS_N(extruder)] != settings.axis_steps_per_mm[E_AXIS_N(last_extruder)]) {
@@ -3194,10 +3247,12 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
       return;
     }
 
-    uint8_t next_buffer_head;
+    TERN_(MERGE_COLLINEAR_MOVES, move_merge.flush());
+
+    block_index_t next_buffer_head;
     block_t * const block = get_next_free_block(next_buffer_head);
 
-    block->flag.reset(BLOCK_BIT_PAGE);
+    plan_of(block).flag.reset(BLOCK_BIT_PAGE);
 
     #if HAS_FAN
       FANS_LOOP(i) block->fan_speed[i] = thermalManager.fan_speed[i];
@@ -3207,6 +3262,12 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
 
     block->page_idx = page_idx;
 
+    TERN_(ACCEL_RAMP_TABLE, block->ramp_scale = 0);
+
+    #if ANY(HAS_WIRED_LCD, MPC_FLOW_LOOKAHEAD)
+      block->segment_time_us = 0; // Not known ahead, so not counted
+    #endif
+
     block->step_event_count = num_steps;
     block->initial_rate = block->final_rate = block->nominal_rate = last_page_step_rate; // steps/s
 
@@ -3237,7 +3298,7 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
     }
 
     // Move buffer head
-    block_buffer_head = next_buffer_head;
+    store_release(block_buffer_head, next_buffer_head);
 
     stepper.enable_all_steppers();
     stepper.wake_up();
@@ -3252,6 +3313,7 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
  * The provided ABCE position is in machine units.
  */
 void Planner::set_machine_position_mm(const abce_pos_t &abce) {
+  TERN_(MERGE_COLLINEAR_MOVES, move_merge.flush());
   TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
   TERN_(HAS_POSITION_FLOAT, position_float = abce);
   position.set(
@@ -3304,6 +3366,7 @@ void Planner::set_position_mm(const xyze_pos_t &xyze) {
    * Setters for planner position (also setting stepper position).
    */
   void Planner::set_e_position_mm(const_float_t e) {
+    TERN_(MERGE_COLLINEAR_MOVES, move_merge.flush());
     const uint8_t axis_index = E_AXIS_N(active_extruder);
     TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
 
@@ -3427,19 +3490,19 @@ void Planner::set_max_feedrate(const AxisEnum axis, float inMaxFeedrateMMS) {
 #if HAS_WIRED_LCD
 
   uint16_t Planner::block_buffer_runtime() {
-    #ifdef __AVR__
-      // Protect the access to the variable. Only required for AVR, as
-      //  any 32bit CPU offers atomic access to 32bit variables
-      const bool was_enabled = stepper.suspend();
-    #endif
-
-    uint32_t bbru = block_buffer_runtime_us;
+    if (!has_blocks_queued()) return 0;
 
+    // The ISR only ever adds to its total, so a stable copy just takes re-reading
+    // on AVR, where the 32-bit read can be interrupted. 32-bit CPUs read it in one go.
+    uint32_t taken;
     #ifdef __AVR__
-      // Reenable Stepper ISR
-      if (was_enabled) stepper.wake_up();
+      do { taken = block_buffer_runtime_taken_us; } while (taken != block_buffer_runtime_taken_us);
+    #else
+      taken = load_acquire(block_buffer_runtime_taken_us);
     #endif
 
+    uint32_t bbru = block_buffer_runtime_us - taken;
+
     // To translate µs to ms a division by 1000 would be required.
     // We introduce 2.4% error here by dividing by 1024.
     // Doesn't matter because block_buffer_runtime_us is already too small an estimation.
@@ -3448,19 +3511,34 @@ void Planner::set_max_feedrate(const AxisEnum axis, float inMaxFeedrateMMS) {
     return _MIN(bbru, 0x0000FFFFUL);
   }
 
+  // Only called while the queue is empty, when the Stepper ISR doesn't touch the totals
   void Planner::clear_block_buffer_runtime() {
-    #ifdef __AVR__
-      // Protect the access to the variable. Only required for AVR, as
-      //  any 32bit CPU offers atomic access to 32bit variables
-      const bool was_enabled = stepper.suspend();
-    #endif
+    block_buffer_runtime_us = block_buffer_runtime_taken_us = 0;
+  }
 
-    block_buffer_runtime_us = 0;
+#endif
 
-    #ifdef __AVR__
-      // Reenable Stepper ISR
-      if (was_enabled) stepper.wake_up();
-    #endif
+#if ENABLED(MPC_FLOW_LOOKAHEAD)
+
+  /**
+   * Walk the queue by nominal block time to find the move the Stepper ISR should
+   * be running lead_us from now, and return its filament speed so the heater can
+   * feed it forward. The running block counts in full, so the true lead is up to
+   * one block shorter. Retraction, other hotends and an empty queue give 0.
+   */
+  float Planner::e_speed_ahead(const uint32_t lead_us, const uint8_t hotend) {
+    uint32_t time_us = 0;
+    for (block_index_t b = load_acquire(block_buffer_tail); b != block_buffer_head; b = next_block_index(b)) {
+      block_t * const block = &block_buffer[b];
+      if (!plan_of(block).is_move()) continue;
+      time_us += block->segment_time_us;
+      if (time_us > lead_us) {
+        if (TERN(HAS_MULTI_HOTEND, block->extruder, 0) != hotend || TEST(block->direction_bits, E_AXIS) || !block->segment_time_us) return 0;
+        return block->steps.e * mm_per_step[E_AXIS_N(block->extruder)] * 1000000.0f / block->segment_time_us;
+      }
+    }
+    return 0;
   }
 
 #endif
+
@@ -45,6 +45,7 @@
 
 #include "motion.h"
 #include "../gcode/queue.h"
+#include "../libs/spsc_ring.h"
 
 #if ENABLED(DELTA)
   #include "delta.h"
@@ -179,15 +180,14 @@ typedef struct {
 #endif
 
 /**
- * struct block_t
- *
- * A single entry in the planner buffer.
- * Tracks linear movement over multiple axes.
+ * struct block_plan_t
  *
- * The "nominal" values are as-specified by G-code, and
- * may never actually be reached due to acceleration limits.
+ * The fields of a planner block that the look-ahead passes work on.
+ * With PLANNER_SPLIT_BLOCK these live in Planner::block_plan, a dense array
+ * parallel to the block buffer, so the passes don't stride over the stepper
+ * fields. Otherwise they are part of block_t. Use Planner::plan_of(block).
  */
-typedef struct PlannerBlock {
+typedef struct PlannerBlockPlan {
 
   volatile block_flags_t flag;              // Block flags
 
@@ -204,6 +204,27 @@ typedef struct PlannerBlock {
         millimeters,                        // The total travel of this block in mm
         acceleration;                       // acceleration mm/sec^2
 
+  void reset() { memset((char*)this, 0, sizeof(*this)); }
+
+} block_plan_t;
+
+#if ENABLED(PLANNER_SPLIT_BLOCK)
+  typedef struct {} block_plan_base_t;      // Planning fields are in Planner::block_plan
+#else
+  typedef block_plan_t block_plan_base_t;
+#endif
+
+/**
+ * struct block_t
+ *
+ * A single entry in the planner buffer.
+ * Tracks linear movement over multiple axes.
+ *
+ * The "nominal" values are as-specified by G-code, and
+ * may never actually be reached due to acceleration limits.
+ */
+typedef struct PlannerBlock : block_plan_base_t {
+
   union {
     abce_ulong_t steps;                     // Step count along each axis
     abce_long_t position;                   // New position to force when this sync block is executed
@@ -234,6 +255,12 @@ typedef struct PlannerBlock {
     uint32_t acceleration_rate;             // The acceleration rate used for acceleration calculation
   #endif
 
+  #if ENABLED(ACCEL_RAMP_TABLE)
+    uint32_t ramp_scale,                    // Interval scale of the acceleration ramp, or 0 to calculate speeds
+             ramp_frac;                     // Fraction of the ramp segment where the block starts
+    uint8_t  ramp_seg;                      // Ramp segment where the block starts
+  #endif
+
   axis_bits_t direction_bits;               // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
 
   // Advance extrusion
@@ -265,7 +292,7 @@ typedef struct PlannerBlock {
     uint8_t valve_pressure, e_to_p_pressure;
   #endif
 
-  #if HAS_WIRED_LCD
+  #if ANY(HAS_WIRED_LCD, MPC_FLOW_LOOKAHEAD)
     uint32_t segment_time_us;
   #endif
 
@@ -286,11 +313,14 @@ typedef struct PlannerBlock {
   #define HAS_POSITION_FLOAT 1
 #endif
 
-constexpr uint8_t block_dec_mod(const uint8_t v1, const uint8_t v2) {
+// Block buffer indices and counts. 16-bit for buffers over 255 blocks (32-bit only).
+typedef uvalue_t(BLOCK_BUFFER_SIZE) block_index_t;
+
+constexpr block_index_t block_dec_mod(const block_index_t v1, const block_index_t v2) {
   return v1 >= v2 ? v1 - v2 : v1 - v2 + BLOCK_BUFFER_SIZE;
 }
 
-constexpr uint8_t block_inc_mod(const uint8_t v1, const uint8_t v2) {
+constexpr block_index_t block_inc_mod(const block_index_t v1, const block_index_t v2) {
   return v1 + v2 < BLOCK_BUFFER_SIZE ? v1 + v2 : v1 + v2 - BLOCK_BUFFER_SIZE;
 }
 
@@ -400,13 +430,30 @@ class Planner {
      *
      *  Writer of head is Planner::buffer_segment().
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
+     *
+     *  The head and tail are each written by only one side, so the Stepper ISR never
+     *  has to be suspended to queue a block. The head is published with store_release()
+     *  after the block is complete and the ISR reads it with load_acquire(), and likewise
+     *  for the tail in the other direction. See libs/spsc_ring.h.
+     *
+     *  block_buffer_planned is written by both. The ISR pushes it past a block it takes,
+     *  so the planner reads it once with load_acquire() and follows any change made
+     *  during a pass (see reverse_pass()).
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
-    static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
-                            block_buffer_nonbusy,   // Index of the first non busy block
-                            block_buffer_planned,   // Index of the optimally planned block
-                            block_buffer_tail;      // Index of the busy block, if any
+    #if ENABLED(PLANNER_SPLIT_BLOCK)
+      static block_plan_t block_plan[BLOCK_BUFFER_SIZE]; // Planning fields of each block in block_buffer
+    #endif
+    static volatile block_index_t block_buffer_head,      // Index of the next block to be pushed
+                                  block_buffer_nonbusy,   // Index of the first non busy block
+                                  block_buffer_planned,   // Index of the optimally planned block
+                                  block_buffer_tail;      // Index of the busy block, if any
     static uint16_t cleaning_buffer_counter;        // A counter to disable queuing of blocks
+
+    // The planning fields of a block in the buffer
+    FORCE_INLINE static block_plan_t& plan_of(const block_t * const block) {
+      return TERN(PLANNER_SPLIT_BLOCK, block_plan[block - block_buffer], *const_cast<block_t*>(block));
+    }
     static uint8_t delay_before_delivering;         // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
     #if ENABLED(DISTINCT_E_FACTORS)
@@ -538,7 +585,10 @@ class Planner {
     #endif
 
     #if HAS_WIRED_LCD
-      volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
+      // Theoretical block buffer runtime in µs is the difference of two running totals,
+      // each written by one side only, so neither side has to hold off the other.
+      static uint32_t block_buffer_runtime_us;            // Runtime of all queued blocks (main loop)
+      volatile static uint32_t block_buffer_runtime_taken_us; // Runtime of all blocks taken by the Stepper ISR
     #endif
 
   public:
@@ -750,19 +800,19 @@ class Planner {
     #endif // HAS_POSITION_MODIFIERS
 
     // Number of moves currently in the planner including the busy block, if any
-    FORCE_INLINE static uint8_t movesplanned() { return block_dec_mod(block_buffer_head, block_buffer_tail); }
+    FORCE_INLINE static block_index_t movesplanned() { return block_dec_mod(load_acquire(block_buffer_head), load_acquire(block_buffer_tail)); }
 
     // Number of nonbusy moves currently in the planner
-    FORCE_INLINE static uint8_t nonbusy_movesplanned() { return block_dec_mod(block_buffer_head, block_buffer_nonbusy); }
+    FORCE_INLINE static block_index_t nonbusy_movesplanned() { return block_dec_mod(load_acquire(block_buffer_head), load_acquire(block_buffer_nonbusy)); }
 
     // Remove all blocks from the buffer
     FORCE_INLINE static void clear_block_buffer() { block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0; }
 
     // Check if movement queue is full
-    FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
+    FORCE_INLINE static bool is_full() { return load_acquire(block_buffer_tail) == next_block_index(block_buffer_head); }
 
     // Get count of movement slots free
-    FORCE_INLINE static uint8_t moves_free() { return (BLOCK_BUFFER_SIZE) - 1 - movesplanned(); }
+    FORCE_INLINE static block_index_t moves_free() { return (BLOCK_BUFFER_SIZE) - 1 - movesplanned(); }
 
     /**
      * Planner::get_next_free_block
@@ -771,7 +821,7 @@ class Planner {
      * - Wait for the number of spaces to open up in the planner
      * - Return the first head block
      */
-    FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
+    FORCE_INLINE static block_t* get_next_free_block(block_index_t &next_buffer_head, const block_index_t count=1) {
 
       // Wait until there are enough slots free
       while (moves_free() < count) { idle(); }
@@ -957,7 +1007,7 @@ class Planner {
     /**
      * Does the buffer have any blocks queued?
      */
-    FORCE_INLINE static bool has_blocks_queued() { return (block_buffer_head != block_buffer_tail); }
+    FORCE_INLINE static bool has_blocks_queued() { return (load_acquire(block_buffer_head) != load_acquire(block_buffer_tail)); }
 
     /**
      * Get the current block for processing
@@ -975,7 +1025,7 @@ class Planner {
      */
     FORCE_INLINE static void release_current_block() {
       if (has_blocks_queued())
-        block_buffer_tail = next_block_index(block_buffer_tail);
+        store_release(block_buffer_tail, next_block_index(block_buffer_tail));
     }
 
     #if HAS_WIRED_LCD
@@ -983,6 +1033,11 @@ class Planner {
       static void clear_block_buffer_runtime();
     #endif
 
+    #if ENABLED(MPC_FLOW_LOOKAHEAD)
+      // Filament speed (mm/s) into the hotend expected to be running lead_us from now
+      static float e_speed_ahead(const uint32_t lead_us, const uint8_t hotend);
+    #endif
+
     #if ENABLED(AUTOTEMP)
       static celsius_t autotemp_min, autotemp_max;
       static float autotemp_factor;
@@ -1013,8 +1068,8 @@ class Planner {
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static constexpr uint8_t next_block_index(const uint8_t block_index) { return block_inc_mod(block_index, 1); }
-    static constexpr uint8_t prev_block_index(const uint8_t block_index) { return block_dec_mod(block_index, 1); }
+    static constexpr block_index_t next_block_index(const block_index_t block_index) { return block_inc_mod(block_index, 1); }
+    static constexpr block_index_t prev_block_index(const block_index_t block_index) { return block_dec_mod(block_index, 1); }
 
     /**
      * Calculate the maximum allowable speed squared at this point, in order
@@ -1036,13 +1091,13 @@ class Planner {
 
     static void calculate_trapezoid_for_block(block_t * const block, const_float_t entry_factor, const_float_t exit_factor);
 
-    static void reverse_pass_kernel(block_t * const current, const block_t * const next OPTARG(ARC_SUPPORT, const_float_t safe_exit_speed_sqr));
-    static void forward_pass_kernel(const block_t * const previous, block_t * const current, uint8_t block_index);
+    static bool reverse_pass_kernel(block_t * const current, const block_t * const next OPTARG(ARC_SUPPORT, const_float_t safe_exit_speed_sqr));
+    static void forward_pass_kernel(const block_t * const previous, block_t * const current, const block_index_t block_index);
 
     static void reverse_pass(TERN_(ARC_SUPPORT, const_float_t safe_exit_speed_sqr));
     static void forward_pass();
 
-    static void recalculate_trapezoids(TERN_(ARC_SUPPORT, const_float_t safe_exit_speed_sqr));
+    static void recalculate_trapezoids(const block_index_t first_block_index OPTARG(ARC_SUPPORT, const_float_t safe_exit_speed_sqr));
 
     static void recalculate(TERN_(ARC_SUPPORT, const_float_t safe_exit_speed_sqr));
 
@@ -36,7 +36,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V88"
+#define EEPROM_VERSION "V90"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -69,6 +69,10 @@
   #endif
 #endif
 
+#if ENABLED(MESH_STORE_SDCARD)
+  #include "../sd/cardreader.h"
+#endif
+
 #if ENABLED(Z_STEPPER_AUTO_ALIGN)
   #include "../feature/z_stepper_align.h"
 #endif
@@ -592,10 +596,19 @@ typedef struct SettingsDataStruct {
   #if ENABLED(INPUT_SHAPING_X)
     float shaping_x_frequency,                          // M593 X F
           shaping_x_zeta;                               // M593 X D
+    uint8_t shaping_x_type;                             // M593 X T
   #endif
   #if ENABLED(INPUT_SHAPING_Y)
     float shaping_y_frequency,                          // M593 Y F
           shaping_y_zeta;                               // M593 Y D
+    uint8_t shaping_y_type;                             // M593 Y T
+  #endif
+
+  //
+  // Multistepping limits
+  //
+  #if ENABLED(CALIBRATE_MULTISTEPPING)
+    uint32_t multistep_limit[8];                        // M881 C
   #endif
 
 } SettingsData;
@@ -641,7 +654,9 @@ void MarlinSettings::postprocess() {
 
   TERN_(ENABLE_LEVELING_FADE_HEIGHT, set_z_fade_height(new_z_fade_height, false)); // false = no report
 
-  TERN_(AUTO_BED_LEVELING_BILINEAR, bedlevel.refresh_bed_level());
+  #if ANY(AUTO_BED_LEVELING_BILINEAR, AUTO_BED_LEVELING_UBL)
+    bedlevel.refresh_bed_level();
+  #endif
 
   TERN_(HAS_MOTOR_CURRENT_PWM, stepper.refresh_motor_power());
 
@@ -1661,13 +1676,22 @@ void MarlinSettings::postprocess() {
       #if ENABLED(INPUT_SHAPING_X)
         EEPROM_WRITE(stepper.get_shaping_frequency(X_AXIS));
         EEPROM_WRITE(stepper.get_shaping_damping_ratio(X_AXIS));
+        EEPROM_WRITE(stepper.get_shaping_type(X_AXIS));
       #endif
       #if ENABLED(INPUT_SHAPING_Y)
         EEPROM_WRITE(stepper.get_shaping_frequency(Y_AXIS));
         EEPROM_WRITE(stepper.get_shaping_damping_ratio(Y_AXIS));
+        EEPROM_WRITE(stepper.get_shaping_type(Y_AXIS));
       #endif
     #endif
 
+    //
+    // Multistepping limits
+    //
+    #if ENABLED(CALIBRATE_MULTISTEPPING)
+      EEPROM_WRITE(stepper.multistep_limit);
+    #endif
+
     //
     // Report final CRC and Data Size
     //
@@ -2708,18 +2732,43 @@ void MarlinSettings::postprocess() {
       #if ENABLED(INPUT_SHAPING_X)
       {
         float _data[2];
+        uint8_t _type;
         EEPROM_READ(_data);
+        EEPROM_READ(_type);
+        if (_type >= NUM_SHAPING_TYPES || shaping_impulses(ShapingType(_type)) > SHAPING_MAX_IMPULSES) _type = SHAPING_ZV;
         stepper.set_shaping_frequency(X_AXIS, _data[0]);
         stepper.set_shaping_damping_ratio(X_AXIS, _data[1]);
+        stepper.set_shaping_type(X_AXIS, ShapingType(_type));
       }
       #endif
 
       #if ENABLED(INPUT_SHAPING_Y)
       {
         float _data[2];
+        uint8_t _type;
         EEPROM_READ(_data);
+        EEPROM_READ(_type);
+        if (_type >= NUM_SHAPING_TYPES || shaping_impulses(ShapingType(_type)) > SHAPING_MAX_IMPULSES) _type = SHAPING_ZV;
         stepper.set_shaping_frequency(Y_AXIS, _data[0]);
         stepper.set_shaping_damping_ratio(Y_AXIS, _data[1]);
+        stepper.set_shaping_type(Y_AXIS, ShapingType(_type));
+      }
+      #endif
+
+      //
+      // Multistepping limits
+      //
+      #if ENABLED(CALIBRATE_MULTISTEPPING)
+      {
+        uint32_t _limits[8];
+        EEPROM_READ(_limits);
+        // Each level must be a lower ISR rate than the one before
+        bool valid = _limits[7] != 0;
+        for (uint8_t i = 1; i < 8; ++i) if (_limits[i] > _limits[i - 1]) valid = false;
+        if (!validating) {
+          if (valid) stepper.set_multistep_limits(_limits);
+          else stepper.reset_multistep_limits();
+        }
       }
       #endif
 
@@ -2857,15 +2906,86 @@ void MarlinSettings::postprocess() {
       return (datasize() + EEPROM_OFFSET + 32) & 0xFFF8;
     }
 
-    #define MESH_STORE_SIZE sizeof(TERN(OPTIMIZED_MESH_STORAGE, mesh_store_t, bedlevel.z_values))
+    #if ENABLED(COMPRESSED_MESH_STORAGE)
+      // A 16-bit length followed by the packed mesh
+      #define MESH_STORE_SIZE (COMPRESSED_MESH_SLOT_SIZE)
+    #else
+      #define MESH_STORE_SIZE sizeof(TERN(OPTIMIZED_MESH_STORAGE, mesh_store_t, bedlevel.z_values))
+    #endif
 
-    uint16_t MarlinSettings::calc_num_meshes() {
-      return (meshes_end - meshes_start_index()) / MESH_STORE_SIZE;
-    }
+    #if ENABLED(MESH_STORE_SDCARD)
 
-    int MarlinSettings::mesh_slot_offset(const int8_t slot) {
-      return meshes_end - (slot + 1) * MESH_STORE_SIZE;
-    }
+      uint16_t MarlinSettings::calc_num_meshes() { return MESH_STORE_SD_SLOTS; }
+
+      int MarlinSettings::mesh_slot_offset(const int8_t) { return 0; }
+
+      /**
+       * Mesh slots are kept in the media root as MESH00.UBL, MESH01.UBL, etc.
+       * Each file is a small header followed by the mesh, stored just as
+       * it would be in an EEPROM slot.
+       */
+      struct mesh_file_header_t {
+        char magic[2];
+        uint8_t grid_x, grid_y;
+        uint16_t size, crc;
+      };
+
+      static void mesh_file_name(char (&name)[13], const int8_t slot) {
+        sprintf_P(name, PSTR("MESH%02i.UBL"), int(slot));
+      }
+
+      // Return 'true' on error
+      static bool write_mesh_file(const int8_t slot, const uint8_t * const src, const uint16_t size) {
+        if (!card.isMounted()) return true;
+        char name[13];
+        mesh_file_name(name, slot);
+        mesh_file_header_t header = { { 'U', 'M' }, GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y, size, 0 };
+        crc16(&header.crc, src, size);
+        MediaFile file, root = card.getroot();
+        if (!file.open(&root, name, O_CREAT | O_WRITE | O_TRUNC)) return true;
+        const bool ok = file.write(&header, sizeof(header)) == int16_t(sizeof(header))
+                     && file.write(src, size) == int16_t(size);
+        return !(file.close() && ok);
+      }
+
+      // Read a mesh file with a single read. A compressed mesh may be shorter
+      // than 'maxsize' but others must fill it. Return 'true' on error.
+      static bool read_mesh_file(const int8_t slot, uint8_t * const dest, const uint16_t maxsize) {
+        if (!card.isMounted()) return true;
+        char name[13];
+        mesh_file_name(name, slot);
+        MediaFile file, root = card.getroot();
+        if (!file.open(&root, name, O_READ)) return true;
+        mesh_file_header_t header;
+        bool ok = file.read(&header, sizeof(header)) == int16_t(sizeof(header))
+               && header.magic[0] == 'U' && header.magic[1] == 'M'
+               && header.grid_x == GRID_MAX_POINTS_X && header.grid_y == GRID_MAX_POINTS_Y
+               && TERN(COMPRESSED_MESH_STORAGE, WITHIN(header.size, 2, maxsize), header.size == maxsize)
+               && file.read(dest, header.size) == int16_t(header.size);
+        file.close();
+        if (ok) {
+          uint16_t crc = 0;
+          crc16(&crc, dest, header.size);
+          ok = crc == header.crc;
+        }
+        #if ENABLED(COMPRESSED_MESH_STORAGE)
+          // The packed length must cover exactly the rest of the file
+          if (ok) ok = (dest[0] | (dest[1] << 8)) + 2 == header.size;
+        #endif
+        return !ok;
+      }
+
+    #else // !MESH_STORE_SDCARD
+
+      uint16_t MarlinSettings::calc_num_meshes() {
+        return (meshes_end - meshes_start_index()) / MESH_STORE_SIZE;
+      }
+
+      int MarlinSettings::mesh_slot_offset(const int8_t slot) {
+        return meshes_end - (slot + 1) * MESH_STORE_SIZE;
+      }
+
+    #endif
 
     void MarlinSettings::store_mesh(const int8_t slot) {
 
@@ -2878,21 +2998,38 @@ void MarlinSettings::postprocess() {
           return;
         }
 
-        int pos = mesh_slot_offset(slot);
-        uint16_t crc = 0;
-
-        #if ENABLED(OPTIMIZED_MESH_STORAGE)
+        #if ENABLED(COMPRESSED_MESH_STORAGE)
+          uint8_t z_mesh_packed[MESH_STORE_SIZE];
+          const uint16_t packed_size = bedlevel.pack_mesh(bedlevel.z_values, z_mesh_packed + 2, MESH_STORE_SIZE - 2);
+          if (!packed_size) {
+            SERIAL_ECHOLNPGM("?Mesh too large for slot. Increase COMPRESSED_MESH_SLOT_SIZE.");
+            return;
+          }
+          z_mesh_packed[0] = packed_size & 0xFF;
+          z_mesh_packed[1] = packed_size >> 8;
+          uint8_t * const src = z_mesh_packed;
+          const uint16_t size = packed_size + 2;
+        #elif ENABLED(OPTIMIZED_MESH_STORAGE)
           int16_t z_mesh_store[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
           bedlevel.set_store_from_mesh(bedlevel.z_values, z_mesh_store);
           uint8_t * const src = (uint8_t*)&z_mesh_store;
+          constexpr uint16_t size = MESH_STORE_SIZE;
         #else
           uint8_t * const src = (uint8_t*)&bedlevel.z_values;
+          constexpr uint16_t size = MESH_STORE_SIZE;
         #endif
 
-        // Write crc to MAT along with other data, or just tack on to the beginning or end
-        persistentStore.access_start();
-        const bool status = persistentStore.write_data(pos, src, MESH_STORE_SIZE, &crc);
-        persistentStore.access_finish();
+        #if ENABLED(MESH_STORE_SDCARD)
+          const bool status = write_mesh_file(slot, src, size);
+        #else
+          int pos = mesh_slot_offset(slot);
+          uint16_t crc = 0;
+
+          // Write crc to MAT along with other data, or just tack on to the beginning or end
+          persistentStore.access_start();
+          const bool status = persistentStore.write_data(pos, src, size, &crc);
+          persistentStore.access_finish();
+        #endif
 
         if (status) SERIAL_ECHOLNPGM("?Unable to save mesh data.");
         else        DEBUG_ECHOLNPGM("Mesh saved in slot ", slot);
@@ -2915,29 +3052,56 @@ void MarlinSettings::postprocess() {
           return;
         }
 
-        int pos = mesh_slot_offset(slot);
-        uint16_t crc = 0;
-        #if ENABLED(OPTIMIZED_MESH_STORAGE)
+        #if ENABLED(COMPRESSED_MESH_STORAGE)
+          uint8_t z_mesh_packed[MESH_STORE_SIZE];
+          uint8_t * const dest = z_mesh_packed;
+        #elif ENABLED(OPTIMIZED_MESH_STORAGE)
           int16_t z_mesh_store[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
           uint8_t * const dest = (uint8_t*)&z_mesh_store;
         #else
           uint8_t * const dest = into ? (uint8_t*)into : (uint8_t*)&bedlevel.z_values;
         #endif
 
-        persistentStore.access_start();
-        uint16_t status = persistentStore.read_data(pos, dest, MESH_STORE_SIZE, &crc);
-        persistentStore.access_finish();
+        #if ENABLED(MESH_STORE_SDCARD)
+          uint16_t status = read_mesh_file(slot, dest, MESH_STORE_SIZE);
+        #else
+          int pos = mesh_slot_offset(slot);
+          uint16_t crc = 0;
+          persistentStore.access_start();
+          #if ENABLED(COMPRESSED_MESH_STORAGE)
+            // Read the length first, then only the packed data
+            uint16_t status = persistentStore.read_data(pos, dest, 2, &crc);
+            const uint16_t packed_size = dest[0] | (dest[1] << 8);
+            if (!status) status = packed_size > MESH_STORE_SIZE - 2 || persistentStore.read_data(pos, dest + 2, packed_size, &crc);
+          #else
+            uint16_t status = persistentStore.read_data(pos, dest, MESH_STORE_SIZE, &crc);
+          #endif
+          persistentStore.access_finish();
+        #endif
 
-        #if ENABLED(OPTIMIZED_MESH_STORAGE)
-          if (into) {
-            float z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
-            bedlevel.set_mesh_from_store(z_mesh_store, z_values);
-            memcpy(into, z_values, sizeof(z_values));
+        #if ENABLED(COMPRESSED_MESH_STORAGE)
+          if (!status) {
+            bed_mesh_t &z_values = into ? *(bed_mesh_t*)into : bedlevel.z_values;
+            status = !bedlevel.unpack_mesh(z_mesh_packed + 2, z_mesh_packed[0] | (z_mesh_packed[1] << 8), z_values);
+            if (status && !into) bedlevel.invalidate();
           }
-          else
-            bedlevel.set_mesh_from_store(z_mesh_store, bedlevel.z_values);
+        #elif ENABLED(OPTIMIZED_MESH_STORAGE)
+          if (!status) {
+            if (into) {
+              float z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+              bedlevel.set_mesh_from_store(z_mesh_store, z_values);
+              memcpy(into, z_values, sizeof(z_values));
+            }
+            else
+              bedlevel.set_mesh_from_store(z_mesh_store, bedlevel.z_values);
+          }
+        #elif ENABLED(MESH_STORE_SDCARD)
+          // A bad file may have been read partly into the mesh
+          if (status && !into) bedlevel.invalidate();
         #endif
 
+        if (!into) bedlevel.refresh_bed_level();
+
         #if ENABLED(DWIN_LCD_PROUI)
           status = !bedLevelTools.meshvalidate();
           if (status) {
@@ -2951,7 +3115,7 @@ void MarlinSettings::postprocess() {
         if (status) SERIAL_ECHOLNPGM("?Unable to load mesh data.");
         else        DEBUG_ECHOLNPGM("Mesh loaded from slot ", slot);
 
-        EEPROM_FINISH();
+        IF_DISABLED(MESH_STORE_SDCARD, EEPROM_FINISH());
 
       #else
 
@@ -3508,13 +3672,17 @@ void MarlinSettings::reset() {
     #if ENABLED(INPUT_SHAPING_X)
       stepper.set_shaping_frequency(X_AXIS, SHAPING_FREQ_X);
       stepper.set_shaping_damping_ratio(X_AXIS, SHAPING_ZETA_X);
+      stepper.set_shaping_type(X_AXIS, ShapingType(SHAPING_TYPE_X));
     #endif
     #if ENABLED(INPUT_SHAPING_Y)
       stepper.set_shaping_frequency(Y_AXIS, SHAPING_FREQ_Y);
       stepper.set_shaping_damping_ratio(Y_AXIS, SHAPING_ZETA_Y);
+      stepper.set_shaping_type(Y_AXIS, ShapingType(SHAPING_TYPE_Y));
     #endif
   #endif
 
+  TERN_(CALIBRATE_MULTISTEPPING, stepper.reset_multistep_limits());
+
   postprocess();
 
   #if ANY(EEPROM_CHITCHAT, DEBUG_LEVELING_FEATURE)
@@ -3630,7 +3798,7 @@ void MarlinSettings::reset() {
           SERIAL_EOL();
           bedlevel.report_state();
           SERIAL_ECHO_MSG("Active Mesh Slot ", bedlevel.storage_slot);
-          SERIAL_ECHO_MSG("EEPROM can hold ", calc_num_meshes(), " meshes.\n");
+          SERIAL_ECHO_MSG(TERN(MESH_STORE_SDCARD, "Media", "EEPROM"), " can hold ", calc_num_meshes(), " meshes.\n");
         }
 
        //bedlevel.report_current_mesh();   // This is too verbose for large meshes. A better (more terse)
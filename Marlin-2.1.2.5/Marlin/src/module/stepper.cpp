@@ -137,6 +137,12 @@ Stepper stepper; // Singleton
   #include "../lcd/extui/ui_api.h"
 #endif
 
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #include "../feature/isr_profiler.h"
+#else
+  #define ISR_PROFILE(P, CODE) CODE
+#endif
+
 #if ENABLED(I2S_STEPPER_STREAM)
   #include "../HAL/ESP32/i2s.h"
 #endif
@@ -239,17 +245,19 @@ uint32_t Stepper::advance_divisor = 0,
   uint16_t            ShapingQueue::tail = 0;
 
   #if ENABLED(INPUT_SHAPING_X)
-    shaping_time_t  ShapingQueue::delay_x;
-    shaping_time_t  ShapingQueue::peek_x_val = shaping_time_t(-1);
-    uint16_t        ShapingQueue::head_x = 0;
-    uint16_t        ShapingQueue::_free_count_x = shaping_echoes - 1;
+    uint8_t         ShapingQueue::echoes_x = 1;
+    shaping_time_t  ShapingQueue::delay_x[shaping_max_echoes];
+    shaping_time_t  ShapingQueue::peek_x_val[shaping_max_echoes];
+    uint16_t        ShapingQueue::head_x[shaping_max_echoes];
+    uint16_t        ShapingQueue::_free_count_x[shaping_max_echoes];
     ShapeParams     Stepper::shaping_x;
   #endif
   #if ENABLED(INPUT_SHAPING_Y)
-    shaping_time_t  ShapingQueue::delay_y;
-    shaping_time_t  ShapingQueue::peek_y_val = shaping_time_t(-1);
-    uint16_t        ShapingQueue::head_y = 0;
-    uint16_t        ShapingQueue::_free_count_y = shaping_echoes - 1;
+    uint8_t         ShapingQueue::echoes_y = 1;
+    shaping_time_t  ShapingQueue::delay_y[shaping_max_echoes];
+    shaping_time_t  ShapingQueue::peek_y_val[shaping_max_echoes];
+    uint16_t        ShapingQueue::head_y[shaping_max_echoes];
+    uint16_t        ShapingQueue::_free_count_y[shaping_max_echoes];
     ShapeParams     Stepper::shaping_y;
   #endif
 #endif
@@ -267,6 +275,12 @@ int32_t Stepper::ticks_nominal = -1;
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
 #endif
 
+#if ENABLED(ACCEL_RAMP_TABLE)
+  uint8_t Stepper::ramp_seg, Stepper::ramp_shift;
+  uint32_t Stepper::ramp_frac, Stepper::ramp_inc;
+  ramp_ticks_t Stepper::ramp_ticks, Stepper::ramp_delta;
+#endif
+
 xyz_long_t Stepper::endstops_trigsteps;
 xyze_long_t Stepper::count_position{0};
 xyze_int8_t Stepper::count_direction{0};
@@ -1475,6 +1489,8 @@ void Stepper::isr() {
   // periods to big periods are respected and the timer does not reset to 0
   HAL_timer_set_compare(MF_TIMER_STEP, hal_timer_t(HAL_TIMER_TYPE_MAX));
 
+  TERN_(STEPPER_ISR_PROFILE, const uint32_t isr_start = ISRProfiler::now());
+
   // Count of ticks for the next ISR
   hal_timer_t next_isr_ticks = 0;
 
@@ -1487,13 +1503,13 @@ void Stepper::isr() {
     // Enable ISRs to reduce USART processing latency
     hal.isr_on();
 
-    TERN_(HAS_ZV_SHAPING, shaping_isr());               // Do Shaper stepping, if needed
+    TERN_(HAS_ZV_SHAPING, ISR_PROFILE(SHAPING, shaping_isr())); // Do Shaper stepping, if needed
 
-    if (!nextMainISR) pulse_phase_isr();                // 0 = Do coordinated axes Stepper pulses
+    if (!nextMainISR) ISR_PROFILE(PULSE, pulse_phase_isr()); // 0 = Do coordinated axes Stepper pulses
 
     #if ENABLED(LIN_ADVANCE)
       if (!nextAdvanceISR) {                            // 0 = Do Linear Advance E Stepper pulses
-        advance_isr();
+        ISR_PROFILE(ADVANCE, advance_isr());
         nextAdvanceISR = la_interval;
       }
       else if (nextAdvanceISR == LA_ADV_NEVER)          // Start LA steps if necessary
@@ -1502,12 +1518,12 @@ void Stepper::isr() {
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       const bool is_babystep = (nextBabystepISR == 0);  // 0 = Do Babystepping (XY)Z pulses
-      if (is_babystep) nextBabystepISR = babystepping_isr();
+      if (is_babystep) ISR_PROFILE(BABYSTEP, nextBabystepISR = babystepping_isr());
     #endif
 
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
-    if (!nextMainISR) nextMainISR = block_phase_isr();  // Manage acc/deceleration, get next block
+    if (!nextMainISR) ISR_PROFILE(BLOCK, nextMainISR = block_phase_isr()); // Manage acc/deceleration, get next block
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       if (is_babystep)                                  // Avoid ANY stepping too soon after baby-stepping
@@ -1597,6 +1613,8 @@ void Stepper::isr() {
   // Now 'next_isr_ticks' contains the period to the next Stepper ISR - And we are
   // sure that the time has not arrived yet - Warrantied by the scheduler
 
+  TERN_(STEPPER_ISR_PROFILE, ISRProfiler::add_isr(isr_start));
+
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(MF_TIMER_STEP, hal_timer_t(next_isr_ticks));
 
@@ -1654,6 +1672,7 @@ void Stepper::pulse_phase_isr() {
 
   // Just update the value we will get at the end of the loop
   step_events_completed += events_to_do;
+  TERN_(CALIBRATE_MULTISTEPPING, ISRProfiler::steps_done(events_to_do, steps_per_isr));
 
   TERN_(ISR_PULSE_CONTROL, USING_TIMED_PULSE());
 
@@ -1664,7 +1683,7 @@ void Stepper::pulse_phase_isr() {
   xyze_bool_t step_needed{0};
 
   // Direct Stepping page?
-  const bool is_page = current_block->is_page();
+  const bool is_page = planner.plan_of(current_block).is_page();
 
   do {
     #define _APPLY_STEP(AXIS, INV, ALWAYS) AXIS ##_APPLY_STEP(INV, ALWAYS)
@@ -1888,11 +1907,11 @@ void Stepper::pulse_phase_isr() {
         // do the first part of the secondary bresenham
         #if ENABLED(INPUT_SHAPING_X)
           if (shaping_x.enabled)
-            PULSE_PREP_SHAPING(X, shaping_x.delta_error, shaping_x.factor1 * (shaping_x.forward ? 1 : -1));
+            PULSE_PREP_SHAPING(X, shaping_x.delta_error, shaping_x.factor[0] * (shaping_x.forward ? 1 : -1));
         #endif
         #if ENABLED(INPUT_SHAPING_Y)
           if (shaping_y.enabled)
-            PULSE_PREP_SHAPING(Y, shaping_y.delta_error, shaping_y.factor1 * (shaping_y.forward ? 1 : -1));
+            PULSE_PREP_SHAPING(Y, shaping_y.delta_error, shaping_y.factor[0] * (shaping_y.forward ? 1 : -1));
         #endif
       #endif
     }
@@ -1996,24 +2015,31 @@ void Stepper::pulse_phase_isr() {
 
   void Stepper::shaping_isr() {
     xy_bool_t step_needed{0};
+    TERN_(INPUT_SHAPING_X, int8_t echo_x);
+    TERN_(INPUT_SHAPING_Y, int8_t echo_y);
+
+    // Clear the echoes that are ready to process. If the buffers are too full and risk overflow, also apply echoes early.
+    // Each echo of an axis has its own head, so take them one per pass.
+    #define SHAPING_READY() do{ \
+      TERN_(INPUT_SHAPING_X, echo_x = ShapingQueue::ready_x(steps_per_isr); step_needed[X_AXIS] = echo_x >= 0); \
+      TERN_(INPUT_SHAPING_Y, echo_y = ShapingQueue::ready_y(steps_per_isr); step_needed[Y_AXIS] = echo_y >= 0); \
+    }while(0)
 
-    // Clear the echoes that are ready to process. If the buffers are too full and risk overflo, also apply echoes early.
-    TERN_(INPUT_SHAPING_X, step_needed[X_AXIS] = !ShapingQueue::peek_x() || ShapingQueue::free_count_x() < steps_per_isr);
-    TERN_(INPUT_SHAPING_Y, step_needed[Y_AXIS] = !ShapingQueue::peek_y() || ShapingQueue::free_count_y() < steps_per_isr);
+    SHAPING_READY();
 
     if (bool(step_needed)) while (true) {
       #if ENABLED(INPUT_SHAPING_X)
         if (step_needed[X_AXIS]) {
-          const bool forward = ShapingQueue::dequeue_x();
-          PULSE_PREP_SHAPING(X, shaping_x.delta_error, shaping_x.factor2 * (forward ? 1 : -1));
+          const bool forward = ShapingQueue::dequeue_x(echo_x);
+          PULSE_PREP_SHAPING(X, shaping_x.delta_error, shaping_x.factor[echo_x + 1] * (forward ? 1 : -1));
           PULSE_START(X);
         }
       #endif
 
       #if ENABLED(INPUT_SHAPING_Y)
         if (step_needed[Y_AXIS]) {
-          const bool forward = ShapingQueue::dequeue_y();
-          PULSE_PREP_SHAPING(Y, shaping_y.delta_error, shaping_y.factor2 * (forward ? 1 : -1));
+          const bool forward = ShapingQueue::dequeue_y(echo_y);
+          PULSE_PREP_SHAPING(Y, shaping_y.delta_error, shaping_y.factor[echo_y + 1] * (forward ? 1 : -1));
           PULSE_START(Y);
         }
       #endif
@@ -2034,8 +2060,7 @@ void Stepper::pulse_phase_isr() {
         #endif
       }
 
-      TERN_(INPUT_SHAPING_X, step_needed[X_AXIS] = !ShapingQueue::peek_x() || ShapingQueue::free_count_x() < steps_per_isr);
-      TERN_(INPUT_SHAPING_Y, step_needed[Y_AXIS] = !ShapingQueue::peek_y() || ShapingQueue::free_count_y() < steps_per_isr);
+      SHAPING_READY();
 
       if (!bool(step_needed)) break;
 
@@ -2077,38 +2102,178 @@ uint32_t Stepper::calc_timer_interval(uint32_t step_rate) {
   #endif
 }
 
+#if DISABLED(DISABLE_MULTI_STEPPING) || ENABLED(CALIBRATE_MULTISTEPPING)
+  // The stepping frequency limits for each multistepping rate, estimated from the ISR cycles
+  static const uint32_t multistep_default_limit[] PROGMEM = {
+    (  MAX_STEP_ISR_FREQUENCY_1X     ),
+    (  MAX_STEP_ISR_FREQUENCY_2X >> 1),
+    (  MAX_STEP_ISR_FREQUENCY_4X >> 2),
+    (  MAX_STEP_ISR_FREQUENCY_8X >> 3),
+    ( MAX_STEP_ISR_FREQUENCY_16X >> 4),
+    ( MAX_STEP_ISR_FREQUENCY_32X >> 5),
+    ( MAX_STEP_ISR_FREQUENCY_64X >> 6),
+    (MAX_STEP_ISR_FREQUENCY_128X >> 7)
+  };
+#endif
+
+#if ENABLED(CALIBRATE_MULTISTEPPING)
+
+  uint32_t Stepper::multistep_limit[8];
+
+  #if ENABLED(ACCEL_RAMP_TABLE)
+    static uint32_t multistep_interval[8];  // The limits as shortest step intervals, for the ramp table
+  #endif
+
+  // The ISR reads the limits, so hold it off while they change
+  void Stepper::set_multistep_limits(const uint32_t limits[8]) {
+    const bool awake = suspend();
+    for (uint8_t i = 0; i < 8; ++i) {
+      multistep_limit[i] = limits[i];
+      TERN_(ACCEL_RAMP_TABLE, multistep_interval[i] = uint32_t(STEPPER_TIMER_RATE) / limits[i]);
+    }
+    if (awake) wake_up();
+  }
+
+  void Stepper::reset_multistep_limits() {
+    uint32_t limits[8];
+    for (uint8_t i = 0; i < 8; ++i) limits[i] = pgm_read_dword(&multistep_default_limit[i]);
+    set_multistep_limits(limits);
+  }
+
+  #define MULTISTEP_LIMIT(I) multistep_limit[I]
+  #define MULTISTEP_INTERVAL(I) multistep_interval[I]
+#else
+  #define MULTISTEP_LIMIT(I) uint32_t(pgm_read_dword(&multistep_default_limit[I]))
+  #if ENABLED(ACCEL_RAMP_TABLE)
+    // The same limits as shortest step intervals, for the ramp table
+    #define _MSI(N) uint32_t((STEPPER_TIMER_RATE) / (MAX_STEP_ISR_FREQUENCY_##N##X / (N)))
+    static const uint32_t multistep_default_interval[] PROGMEM = {
+      _MSI(1), _MSI(2), _MSI(4), _MSI(8), _MSI(16), _MSI(32), _MSI(64), _MSI(128)
+    };
+    #undef _MSI
+    #define MULTISTEP_INTERVAL(I) uint32_t(pgm_read_dword(&multistep_default_interval[I]))
+  #endif
+#endif
+
 // Get the timer interval and the number of loops to perform per tick
 uint32_t Stepper::calc_timer_interval(uint32_t step_rate, uint8_t &loops) {
   uint8_t multistep = 1;
   #if DISABLED(DISABLE_MULTI_STEPPING)
-
-    // The stepping frequency limits for each multistepping rate
-    static const uint32_t limit[] PROGMEM = {
-      (  MAX_STEP_ISR_FREQUENCY_1X     ),
-      (  MAX_STEP_ISR_FREQUENCY_2X >> 1),
-      (  MAX_STEP_ISR_FREQUENCY_4X >> 2),
-      (  MAX_STEP_ISR_FREQUENCY_8X >> 3),
-      ( MAX_STEP_ISR_FREQUENCY_16X >> 4),
-      ( MAX_STEP_ISR_FREQUENCY_32X >> 5),
-      ( MAX_STEP_ISR_FREQUENCY_64X >> 6),
-      (MAX_STEP_ISR_FREQUENCY_128X >> 7)
-    };
-
     // Select the proper multistepping
     uint8_t idx = 0;
-    while (idx < 7 && step_rate > (uint32_t)pgm_read_dword(&limit[idx])) {
+    while (idx < 7 && step_rate > MULTISTEP_LIMIT(idx)) {
       step_rate >>= 1;
       multistep <<= 1;
       ++idx;
     };
   #else
-    NOMORE(step_rate, uint32_t(MAX_STEP_ISR_FREQUENCY_1X));
+    NOMORE(step_rate, TERN(CALIBRATE_MULTISTEPPING, multistep_limit[0], uint32_t(MAX_STEP_ISR_FREQUENCY_1X)));
   #endif
   loops = multistep;
 
   return calc_timer_interval(step_rate);
 }
 
+#if ENABLED(ACCEL_RAMP_TABLE)
+
+  /**
+   * Step intervals along one octave of ramp position at an interval scale of 32768,
+   * for even and odd octaves. An octave doubles the distance from standstill, so
+   * the interval shrinks by sqrt(2) and the scale halves every second octave.
+   */
+  static const uint16_t ramp_octave[2][9] PROGMEM = {
+    { 32768, 30894, 29309, 27945, 26755, 25705, 24770, 23930, 23170 },
+    { 23170, 21845, 20724, 19760, 18919, 18176, 17515, 16921, 16384 }
+  };
+
+  // Scale a normalized ramp interval, saturating at the timer limit
+  static ramp_ticks_t ramp_scaled(const uint32_t scale, const uint16_t norm) {
+    #ifdef __AVR__
+      const uint32_t hi = uint32_t(uint16_t(scale >> 16)) * norm;
+      if (hi >= 0x8000UL) return 0xFFFF;
+      const uint32_t ticks = (hi << 1) + ((uint32_t(uint16_t(scale)) * norm) >> 15);
+      return ticks > 0xFFFFUL ? 0xFFFF : ticks;
+    #else
+      const uint64_t ticks = (uint64_t(scale) * norm) >> 15;
+      return ticks > UINT32_MAX ? UINT32_MAX : ticks;
+    #endif
+  }
+
+  // Find the ramp segment and fraction for a position in 1/16 steps
+  void Stepper::ramp_locate(const_float_t pos, uint8_t &seg, uint32_t &frac) {
+    constexpr uint32_t pos_min = _BV32(RAMP_SEG_MIN >> 3), pos_max = _BV32((RAMP_SEG_MAX >> 3) + 1) - 1;
+    const uint32_t p = pos < float(pos_max) ? _MAX(uint32_t(pos), pos_min) : pos_max;
+    uint8_t e = RAMP_SEG_MIN >> 3;
+    while (p >> (e + 1)) ++e;
+    seg = (e << 3) | ((p >> (e - 3)) & 7);
+    const uint32_t rem = p & (_BV32(e - 3) - 1);    // Units into a segment of 2^(e-3)
+    frac = e <= 27 ? rem << (27 - e) : rem >> (e - 27);
+  }
+
+  // Get the interval at the start of the current segment and its change across it
+  void Stepper::ramp_load() {
+    const uint8_t e = ramp_seg >> 3;
+    const uint16_t * const norm = &ramp_octave[e & 1][ramp_seg & 7];
+    const uint32_t scale = current_block->ramp_scale >> (e >> 1);
+    ramp_ticks = ramp_scaled(scale, pgm_read_word(norm));
+    ramp_delta = ramp_ticks - ramp_scaled(scale, pgm_read_word(norm + 1));
+    ramp_inc = _BV32(31 - e);                       // 2^24 * 16 units / 2^(e-3) units per segment
+  }
+
+  // Move up the ramp by the steps just taken. This cannot overflow, since
+  // multistepping only comes into play far up the ramp.
+  void Stepper::ramp_forward() {
+    ramp_frac += ramp_inc << ramp_shift;
+    if (ramp_frac < _BV32(24)) return;
+    do {
+      if (ramp_seg == RAMP_SEG_MAX) { ramp_frac = _BV32(24) - 1; break; }
+      ramp_frac -= _BV32(24);
+      if (!(++ramp_seg & 7)) ramp_frac >>= 1;       // Segments double in length each octave
+    } while (ramp_frac >= _BV32(24));
+    ramp_load();
+  }
+
+  // Move down the ramp by the steps just taken, stopping at the bottom
+  void Stepper::ramp_back() {
+    const uint32_t dist = ramp_inc << ramp_shift;
+    if (dist <= ramp_frac) { ramp_frac -= dist; return; }
+    uint32_t under = dist - ramp_frac;              // Distance left below the segment start
+    for (;;) {
+      if (ramp_seg == RAMP_SEG_MIN) { ramp_frac = 0; break; }
+      if (!(ramp_seg-- & 7)) under <<= 1;           // Segments halve in length each octave
+      if (under <= _BV32(24)) { ramp_frac = _BV32(24) - under; break; }
+      under -= _BV32(24);
+    }
+    ramp_load();
+  }
+
+  // Get the timer interval at the current ramp position and the number of loops per tick
+  uint32_t Stepper::ramp_timer_interval(uint8_t &loops) {
+    const uint8_t f = ramp_frac >> 16;
+    uint32_t interval = ramp_ticks - (
+      #ifdef __AVR__
+        MultiU8X16toH16(f, ramp_delta)
+      #else
+        uint32_t((uint64_t(ramp_delta) * f) >> 8)
+      #endif
+    );
+    uint8_t idx = 0;
+    #if DISABLED(DISABLE_MULTI_STEPPING)
+      // Select the proper multistepping
+      while (idx < 7 && interval < MULTISTEP_INTERVAL(idx)) {
+        interval <<= 1;
+        ++idx;
+      }
+    #else
+      NOLESS(interval, MULTISTEP_INTERVAL(0));
+    #endif
+    ramp_shift = idx;
+    loops = _BV(idx);
+    return interval;
+  }
+
+#endif // ACCEL_RAMP_TABLE
+
 // This is the last half of the stepper interrupt: This one processes and
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
@@ -2132,7 +2297,7 @@ uint32_t Stepper::block_phase_isr() {
             count_position[_AXIS(AXIS)] += page_step_state.bd[_AXIS(AXIS)] * count_direction[_AXIS(AXIS)];
         #endif
 
-        if (current_block->is_page()) {
+        if (planner.plan_of(current_block).is_page()) {
           PAGE_SEGMENT_UPDATE_POS(X);
           PAGE_SEGMENT_UPDATE_POS(Y);
           PAGE_SEGMENT_UPDATE_POS(Z);
@@ -2148,21 +2313,31 @@ uint32_t Stepper::block_phase_isr() {
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate = acceleration_time < current_block->acceleration_time
-                                   ? _eval_bezier_curve(acceleration_time)
-                                   : current_block->cruise_rate;
-        #else
-          acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
+        #if ENABLED(ACCEL_RAMP_TABLE)
+          if (current_block->ramp_scale) {
+            // Move up the precomputed ramp
+            ramp_forward();
+            interval = ramp_timer_interval(steps_per_isr);
+          }
+          else
         #endif
+        {
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // Get the next speed to use (Jerk limited!)
+            uint32_t acc_step_rate = acceleration_time < current_block->acceleration_time
+                                     ? _eval_bezier_curve(acceleration_time)
+                                     : current_block->cruise_rate;
+          #else
+            acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+            NOMORE(acc_step_rate, current_block->nominal_rate);
+          #endif
 
-        // acc_step_rate is in steps/second
+          // acc_step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(acc_step_rate << oversampling_factor, steps_per_isr);
-        acceleration_time += interval;
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(acc_step_rate << oversampling_factor, steps_per_isr);
+          acceleration_time += interval;
+        }
 
         #if ENABLED(LIN_ADVANCE)
           if (current_block->la_advance_rate) {
@@ -2201,38 +2376,48 @@ uint32_t Stepper::block_phase_isr() {
       else if (step_events_completed > decelerate_after) {
         uint32_t step_rate;
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
-
-        #else
-          // Using the old trapezoidal control
-          step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
+        #if ENABLED(ACCEL_RAMP_TABLE)
+          if (current_block->ramp_scale) {
+            // Move back down the precomputed ramp
+            ramp_back();
+            interval = ramp_timer_interval(steps_per_isr);
           }
           else
-            step_rate = current_block->final_rate;
-
         #endif
+        {
+          #if ENABLED(S_CURVE_ACCELERATION)
+
+            // If this is the 1st time we process the 2nd half of the trapezoid...
+            if (!bezier_2nd_half) {
+              // Initialize the Bézier speed curve
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+              bezier_2nd_half = true;
+              // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+              step_rate = current_block->cruise_rate;
+            }
+            else {
+              // Calculate the next speed to use
+              step_rate = deceleration_time < current_block->deceleration_time
+                ? _eval_bezier_curve(deceleration_time)
+                : current_block->final_rate;
+            }
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(step_rate << oversampling_factor, steps_per_isr);
-        deceleration_time += interval;
+          #else
+            // Using the old trapezoidal control
+            step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+            if (step_rate < acc_step_rate) { // Still decelerating?
+              step_rate = acc_step_rate - step_rate;
+              NOLESS(step_rate, current_block->final_rate);
+            }
+            else
+              step_rate = current_block->final_rate;
+
+          #endif
+
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(step_rate << oversampling_factor, steps_per_isr);
+          deceleration_time += interval;
+        }
 
         #if ENABLED(LIN_ADVANCE)
           if (current_block->la_advance_rate) {
@@ -2357,20 +2542,20 @@ uint32_t Stepper::block_phase_isr() {
     if ((current_block = planner.get_current_block())) {
 
       // Sync block? Sync the stepper counts or fan speeds and return
-      while (current_block->is_sync()) {
+      while (planner.plan_of(current_block).is_sync()) {
 
         #if ENABLED(LASER_POWER_SYNC)
           if (cutter.cutter_mode == CUTTER_MODE_CONTINUOUS) {
-            if (current_block->is_pwr_sync()) {
+            if (planner.plan_of(current_block).is_pwr_sync()) {
               planner.laser_inline.status.isSyncPower = true;
               cutter.apply_power(current_block->laser.power);
             }
           }
         #endif
 
-        TERN_(LASER_SYNCHRONOUS_M106_M107, if (current_block->is_fan_sync()) planner.sync_fan_speeds(current_block->fan_speed));
+        TERN_(LASER_SYNCHRONOUS_M106_M107, if (planner.plan_of(current_block).is_fan_sync()) planner.sync_fan_speeds(current_block->fan_speed));
 
-        if (!(current_block->is_fan_sync() || current_block->is_pwr_sync())) _set_position(current_block->position);
+        if (!(planner.plan_of(current_block).is_fan_sync() || planner.plan_of(current_block).is_pwr_sync())) _set_position(current_block->position);
 
         discard_current_block();
 
@@ -2392,7 +2577,7 @@ uint32_t Stepper::block_phase_isr() {
       #endif
 
       #if ENABLED(DIRECT_STEPPING)
-        if (current_block->is_page()) {
+        if (planner.plan_of(current_block).is_page()) {
           page_step_state.segment_steps = 0;
           page_step_state.segment_idx = 0;
           page_step_state.page = page_manager.get_page(current_block->page_idx);
@@ -2613,7 +2798,17 @@ uint32_t Stepper::block_phase_isr() {
       #endif
 
       // Calculate the initial timer interval
-      interval = calc_timer_interval(current_block->initial_rate << oversampling_factor, steps_per_isr);
+      #if ENABLED(ACCEL_RAMP_TABLE)
+        if (current_block->ramp_scale) {
+          // Start where the planner placed the block on the ramp
+          ramp_seg = current_block->ramp_seg;
+          ramp_frac = current_block->ramp_frac;
+          ramp_load();
+          interval = ramp_timer_interval(steps_per_isr);
+        }
+        else
+      #endif
+          interval = calc_timer_interval(current_block->initial_rate << oversampling_factor, steps_per_isr);
       acceleration_time += interval;
 
       #if ENABLED(LIN_ADVANCE)
@@ -2993,6 +3188,9 @@ void Stepper::init() {
     E_AXIS_INIT(7);
   #endif
 
+  TERN_(HAS_ZV_SHAPING, ShapingQueue::purge()); // Empty echo heads before the first step
+  TERN_(STEPPER_ISR_PROFILE, ISRProfiler::reset());
+
   #if DISABLED(I2S_STEPPER_STREAM)
     HAL_timer_start(MF_TIMER_STEP, 122); // Init Stepper ISR to 122 Hz for quick starting
     wake_up();
@@ -3023,29 +3221,68 @@ void Stepper::init() {
 #if HAS_ZV_SHAPING
 
   /**
-   * Calculate a fixed point factor to apply to the signal and its echo
-   * when shaping an axis.
+   * Calculate fixed point factors to apply to the signal and its echoes
+   * when shaping an axis. These are the usual ZV, MZV, EI and 2-hump EI
+   * amplitudes, with 5% vibration tolerance for the EI shapers, rounded
+   * so they always sum to exactly 128 (one step).
    */
-  void Stepper::set_shaping_damping_ratio(const AxisEnum axis, const_float_t zeta) {
-    // from the damping ratio, get a factor that can be applied to advance_dividend for fixed point maths
-    // for ZV, we use amplitudes 1/(1+K) and K/(1+K) where K = exp(-zeta * M_PI / sqrt(1.0f - zeta * zeta))
-    // which can be converted to 1:7 fixed point with an excellent fit with a 3rd order polynomial
-    float factor2;
-    if (zeta <= 0.0f) factor2 = 64.0f;
-    else if (zeta >= 1.0f) factor2 = 0.0f;
-    else {
-      factor2 = 64.44056192 + -99.02008832 * zeta;
-      const_float_t zeta2 = zeta * zeta;
-      factor2 += -7.58095488 * zeta2;
-      const_float_t zeta3 = zeta2 * zeta;
-      factor2 += 43.073216 * zeta3;
-      factor2 = floor(factor2);
+  void Stepper::calc_shaping_factors(const ShapingType type, const_float_t zeta, uint8_t factor[SHAPING_MAX_IMPULSES]) {
+    // K is the decay of the vibration over half a period
+    const float K = zeta <= 0.0f ? 1.0f : zeta >= 1.0f ? 0.0f : expf(-zeta * float(M_PI) / SQRT(1.0f - sq(zeta)));
+    constexpr float v_tol = 0.05f;
+
+    float amp[4] = { 0 };
+    switch (type) {
+      default:
+      case SHAPING_ZV:
+        amp[0] = 1.0f;
+        amp[1] = K;
+        break;
+      case SHAPING_MZV: {
+        const float K3_4 = POW(K, 0.75f); // Decay over 3/8 period
+        constexpr float sqrt2 = 1.41421356f;
+        amp[0] = 1.0f - 1.0f / sqrt2;
+        amp[1] = (sqrt2 - 1.0f) * K3_4;
+        amp[2] = amp[0] * sq(K3_4);
+      } break;
+      case SHAPING_EI:
+        amp[0] = 0.25f * (1.0f + v_tol);
+        amp[1] = 0.5f * (1.0f - v_tol) * K;
+        amp[2] = amp[0] * sq(K);
+        break;
+      case SHAPING_2HUMP_EI: {
+        constexpr float V2 = sq(v_tol);
+        const float X = POW(V2 * (SQRT(1.0f - V2) + 1.0f), 1.0f / 3.0f);
+        amp[0] = (3.0f * sq(X) + 2.0f * X + 3.0f * V2) / (16.0f * X);
+        amp[1] = (0.5f - amp[0]) * K;
+        amp[2] = amp[1] * K;
+        amp[3] = amp[0] * K * sq(K);
+      } break;
     }
 
+    const uint8_t impulses = shaping_impulses(type);
+    float total = 0;
+    for (uint8_t i = 0; i < impulses; ++i) total += amp[i];
+
+    // Round the running sum, not each amplitude, so nothing is lost
+    float sum = 0;
+    uint8_t done = 0;
+    for (uint8_t i = 0; i < SHAPING_MAX_IMPULSES; ++i) {
+      if (i < impulses) sum += amp[i];
+      const uint8_t f = LROUND(sum * 128.0f / total);
+      factor[i] = f - done;
+      done = f;
+    }
+  }
+
+  void Stepper::set_shaping_damping_ratio(const AxisEnum axis, const_float_t zeta) {
+    uint8_t factor[SHAPING_MAX_IMPULSES];
+    calc_shaping_factors(get_shaping_type(axis), zeta, factor);
+
     const bool was_on = hal.isr_state();
     hal.isr_off();
-    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) { shaping_x.factor2 = factor2; shaping_x.factor1 = 128 - factor2; shaping_x.zeta = zeta; })
-    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) { shaping_y.factor2 = factor2; shaping_y.factor1 = 128 - factor2; shaping_y.zeta = zeta; })
+    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) { COPY(shaping_x.factor, factor); shaping_x.zeta = zeta; })
+    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) { COPY(shaping_y.factor, factor); shaping_y.zeta = zeta; })
     if (was_on) hal.isr_on();
   }
 
@@ -3059,13 +3296,19 @@ void Stepper::init() {
     // enabling or disabling shaping whilst moving can result in lost steps
     planner.synchronize();
 
+    // Echoes are spread evenly up to the span of the shaper
+    const ShapingType type = get_shaping_type(axis);
+    const uint8_t echoes = shaping_impulses(type) - 1;
+    shaping_time_t delays[shaping_max_echoes];
+    for (uint8_t i = 0; i < echoes; ++i)
+      delays[i] = freq ? float(uint32_t(STEPPER_TIMER_RATE)) * shaping_span(type) * (i + 1) / echoes / freq : shaping_time_t(-1);
+
     const bool was_on = hal.isr_state();
     hal.isr_off();
 
-    const shaping_time_t delay = freq ? float(uint32_t(STEPPER_TIMER_RATE) / 2) / freq : shaping_time_t(-1);
     #if ENABLED(INPUT_SHAPING_X)
       if (axis == X_AXIS) {
-        ShapingQueue::set_delay(X_AXIS, delay);
+        ShapingQueue::set_delays(X_AXIS, echoes, delays);
         shaping_x.frequency = freq;
         shaping_x.enabled = !!freq;
         shaping_x.delta_error = 0;
@@ -3074,7 +3317,7 @@ void Stepper::init() {
     #endif
     #if ENABLED(INPUT_SHAPING_Y)
       if (axis == Y_AXIS) {
-        ShapingQueue::set_delay(Y_AXIS, delay);
+        ShapingQueue::set_delays(Y_AXIS, echoes, delays);
         shaping_y.frequency = freq;
         shaping_y.enabled = !!freq;
         shaping_y.delta_error = 0;
@@ -3091,6 +3334,24 @@ void Stepper::init() {
     return -1;
   }
 
+  void Stepper::set_shaping_type(const AxisEnum axis, const ShapingType type) {
+    // The echo count changes, so all echoes must be done
+    planner.synchronize();
+
+    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) shaping_x.type = type);
+    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) shaping_y.type = type);
+
+    // Apply the delays and amplitudes of the new shaper
+    set_shaping_frequency(axis, get_shaping_frequency(axis));
+    set_shaping_damping_ratio(axis, get_shaping_damping_ratio(axis));
+  }
+
+  ShapingType Stepper::get_shaping_type(const AxisEnum axis) {
+    TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) return shaping_x.type);
+    TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) return shaping_y.type);
+    return SHAPING_ZV;
+  }
+
 #endif // HAS_ZV_SHAPING
 
 /**
@@ -96,9 +96,9 @@
     #define ISR_S_CURVE_CYCLES 0UL
   #endif
 
-  // Input shaping base time
+  // Input shaping base time, plus time to check each extra echo
   #if HAS_ZV_SHAPING
-    #define ISR_SHAPING_BASE_CYCLES 180UL
+    #define ISR_SHAPING_BASE_CYCLES (180UL + 60UL * ((SHAPING_MAX_IMPULSES) - 2))
   #else
     #define ISR_SHAPING_BASE_CYCLES 0UL
   #endif
@@ -130,9 +130,9 @@
     #define ISR_S_CURVE_CYCLES 0UL
   #endif
 
-  // Input shaping base time
+  // Input shaping base time, plus time to check each extra echo
   #if HAS_ZV_SHAPING
-    #define ISR_SHAPING_BASE_CYCLES 290UL
+    #define ISR_SHAPING_BASE_CYCLES (290UL + 40UL * ((SHAPING_MAX_IMPULSES) - 2))
   #else
     #define ISR_SHAPING_BASE_CYCLES 0UL
   #endif
@@ -219,8 +219,8 @@
 // between pulses for (R-1) pulses. But the user could be enforcing a minimum time so the loop time is:
 #define ISR_LOOP_CYCLES(R) ((ISR_LOOP_BASE_CYCLES + MIN_ISR_LOOP_CYCLES + MIN_STEPPER_PULSE_CYCLES) * (R - 1) + _MAX(MIN_ISR_LOOP_CYCLES, MIN_STEPPER_PULSE_CYCLES))
 
-// Model input shaping as an extra loop call
-#define ISR_SHAPING_LOOP_CYCLES(R) TERN0(HAS_ZV_SHAPING, (R) * ((ISR_LOOP_BASE_CYCLES) + TERN0(INPUT_SHAPING_X, ISR_X_STEPPER_CYCLES) + TERN0(INPUT_SHAPING_Y, ISR_Y_STEPPER_CYCLES)))
+// Model input shaping as an extra loop call for each echo of a step
+#define ISR_SHAPING_LOOP_CYCLES(R) TERN0(HAS_ZV_SHAPING, (R) * ((SHAPING_MAX_IMPULSES) - 1) * ((ISR_LOOP_BASE_CYCLES) + TERN0(INPUT_SHAPING_X, ISR_X_STEPPER_CYCLES) + TERN0(INPUT_SHAPING_Y, ISR_Y_STEPPER_CYCLES)))
 
 // If linear advance is enabled, then it is handled separately
 #if ENABLED(LIN_ADVANCE)
@@ -368,8 +368,23 @@ constexpr ena_mask_t enable_overlap[] = {
   #ifndef SHAPING_MIN_FREQ
     #define SHAPING_MIN_FREQ _MIN(0x7FFFFFFFL OPTARG(INPUT_SHAPING_X, SHAPING_FREQ_X) OPTARG(INPUT_SHAPING_Y, SHAPING_FREQ_Y))
   #endif
+  // Shaper types, numbered as for M593 T
+  enum ShapingType : uint8_t { SHAPING_ZV, SHAPING_EI, SHAPING_2HUMP_EI, SHAPING_MZV, NUM_SHAPING_TYPES };
+
+  // Impulses of each shaper type, and the delay of its last echo in periods of the shaping frequency
+  constexpr uint8_t shaping_impulses(const ShapingType type) {
+    return type == SHAPING_2HUMP_EI ? 4 : type == SHAPING_ZV ? 2 : 3;
+  }
+  constexpr float shaping_span(const ShapingType type) {
+    return type == SHAPING_ZV ? 0.5f : type == SHAPING_MZV ? 0.75f : type == SHAPING_EI ? 1.0f : 1.5f;
+  }
+
+  // Echoes follow the first impulse. The step buffer spans the longest echo delay.
+  constexpr uint8_t shaping_max_echoes = (SHAPING_MAX_IMPULSES) - 1;
+  constexpr float shaping_max_span = shaping_max_echoes == 1 ? 0.5f : shaping_max_echoes == 2 ? 1.0f : 1.5f;
+
   constexpr uint16_t shaping_min_freq = SHAPING_MIN_FREQ,
-                     shaping_echoes = max_step_rate / shaping_min_freq / 2 + 3;
+                     shaping_echoes = max_step_rate * shaping_max_span / shaping_min_freq + 3;
 
   typedef IF<ENABLED(__AVR__), uint16_t, uint32_t>::type shaping_time_t;
   enum shaping_echo_t { ECHO_NONE = 0, ECHO_FWD = 1, ECHO_BWD = 2 };
@@ -378,6 +393,11 @@ constexpr ena_mask_t enable_overlap[] = {
     TERN_(INPUT_SHAPING_Y, shaping_echo_t y:2);
   };
 
+  /**
+   * All shaped axes share one ring of step times. Each echo of an axis has
+   * its own head, which trails the tail by that echo's delay. The last echo
+   * has the longest delay, so its head is always the furthest behind.
+   */
   class ShapingQueue {
     private:
       static shaping_time_t       now;
@@ -386,75 +406,123 @@ constexpr ena_mask_t enable_overlap[] = {
       static uint16_t             tail;
 
       #if ENABLED(INPUT_SHAPING_X)
-        static shaping_time_t delay_x;    // = shaping_time_t(-1) to disable queueing
-        static shaping_time_t peek_x_val;
-        static uint16_t head_x;
-        static uint16_t _free_count_x;
+        static uint8_t        echoes_x;                         // Echoes used by the X shaper
+        static shaping_time_t delay_x[shaping_max_echoes];      // = shaping_time_t(-1) to disable queueing
+        static shaping_time_t peek_x_val[shaping_max_echoes];
+        static uint16_t head_x[shaping_max_echoes];
+        static uint16_t _free_count_x[shaping_max_echoes];
       #endif
       #if ENABLED(INPUT_SHAPING_Y)
-        static shaping_time_t delay_y;    // = shaping_time_t(-1) to disable queueing
-        static shaping_time_t peek_y_val;
-        static uint16_t head_y;
-        static uint16_t _free_count_y;
+        static uint8_t        echoes_y;                         // Echoes used by the Y shaper
+        static shaping_time_t delay_y[shaping_max_echoes];      // = shaping_time_t(-1) to disable queueing
+        static shaping_time_t peek_y_val[shaping_max_echoes];
+        static uint16_t head_y[shaping_max_echoes];
+        static uint16_t _free_count_y[shaping_max_echoes];
       #endif
 
     public:
       static void decrement_delays(const shaping_time_t interval) {
         now += interval;
-        TERN_(INPUT_SHAPING_X, if (peek_x_val != shaping_time_t(-1)) peek_x_val -= interval);
-        TERN_(INPUT_SHAPING_Y, if (peek_y_val != shaping_time_t(-1)) peek_y_val -= interval);
+        #if ENABLED(INPUT_SHAPING_X)
+          for (uint8_t i = 0; i < echoes_x; ++i) if (peek_x_val[i] != shaping_time_t(-1)) peek_x_val[i] -= interval;
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          for (uint8_t i = 0; i < echoes_y; ++i) if (peek_y_val[i] != shaping_time_t(-1)) peek_y_val[i] -= interval;
+        #endif
       }
-      static void set_delay(const AxisEnum axis, const shaping_time_t delay) {
-        TERN_(INPUT_SHAPING_X, if (axis == X_AXIS) delay_x = delay);
-        TERN_(INPUT_SHAPING_Y, if (axis == Y_AXIS) delay_y = delay);
+      // Set the echo delays for an axis. Only call while the queue is empty.
+      static void set_delays(const AxisEnum axis, const uint8_t echoes, const shaping_time_t delays[]) {
+        #if ENABLED(INPUT_SHAPING_X)
+          if (axis == X_AXIS) {
+            echoes_x = echoes;
+            for (uint8_t i = 0; i < echoes; ++i) {
+              delay_x[i] = delays[i]; head_x[i] = head_x[0]; _free_count_x[i] = _free_count_x[0]; peek_x_val[i] = peek_x_val[0];
+            }
+          }
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          if (axis == Y_AXIS) {
+            echoes_y = echoes;
+            for (uint8_t i = 0; i < echoes; ++i) {
+              delay_y[i] = delays[i]; head_y[i] = head_y[0]; _free_count_y[i] = _free_count_y[0]; peek_y_val[i] = peek_y_val[0];
+            }
+          }
+        #endif
       }
       static void enqueue(const bool x_step, const bool x_forward, const bool y_step, const bool y_forward) {
-        TERN_(INPUT_SHAPING_X, if (head_x == tail && x_step) peek_x_val = delay_x);
-        TERN_(INPUT_SHAPING_Y, if (head_y == tail && y_step) peek_y_val = delay_y);
+        #if ENABLED(INPUT_SHAPING_X)
+          if (x_step) for (uint8_t i = 0; i < echoes_x; ++i) if (head_x[i] == tail) peek_x_val[i] = delay_x[i];
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          if (y_step) for (uint8_t i = 0; i < echoes_y; ++i) if (head_y[i] == tail) peek_y_val[i] = delay_y[i];
+        #endif
         times[tail] = now;
         TERN_(INPUT_SHAPING_X, echo_axes[tail].x = x_step ? (x_forward ? ECHO_FWD : ECHO_BWD) : ECHO_NONE);
         TERN_(INPUT_SHAPING_Y, echo_axes[tail].y = y_step ? (y_forward ? ECHO_FWD : ECHO_BWD) : ECHO_NONE);
         if (++tail == shaping_echoes) tail = 0;
-        TERN_(INPUT_SHAPING_X, _free_count_x--);
-        TERN_(INPUT_SHAPING_Y, _free_count_y--);
-        TERN_(INPUT_SHAPING_X, if (echo_axes[head_x].x == ECHO_NONE) dequeue_x());
-        TERN_(INPUT_SHAPING_Y, if (echo_axes[head_y].y == ECHO_NONE) dequeue_y());
+        #if ENABLED(INPUT_SHAPING_X)
+          for (uint8_t i = 0; i < echoes_x; ++i) {
+            _free_count_x[i]--;
+            if (echo_axes[head_x[i]].x == ECHO_NONE) dequeue_x(i);
+          }
+        #endif
+        #if ENABLED(INPUT_SHAPING_Y)
+          for (uint8_t i = 0; i < echoes_y; ++i) {
+            _free_count_y[i]--;
+            if (echo_axes[head_y[i]].y == ECHO_NONE) dequeue_y(i);
+          }
+        #endif
       }
       #if ENABLED(INPUT_SHAPING_X)
-        static shaping_time_t peek_x() { return peek_x_val; }
-        static bool dequeue_x() {
-          bool forward = echo_axes[head_x].x == ECHO_FWD;
+        static shaping_time_t peek_x() {
+          shaping_time_t t = peek_x_val[0];
+          for (uint8_t i = 1; i < echoes_x; ++i) NOMORE(t, peek_x_val[i]);
+          return t;
+        }
+        // The first echo that is due, or has to be applied early to avoid overflow. -1 if none.
+        static int8_t ready_x(const uint16_t min_free) {
+          for (uint8_t i = 0; i < echoes_x; ++i) if (!peek_x_val[i] || _free_count_x[i] < min_free) return i;
+          return -1;
+        }
+        static bool dequeue_x(const uint8_t i) {
+          bool forward = echo_axes[head_x[i]].x == ECHO_FWD;
           do {
-            _free_count_x++;
-            if (++head_x == shaping_echoes) head_x = 0;
-          } while (head_x != tail && echo_axes[head_x].x == ECHO_NONE);
-          peek_x_val = head_x == tail ? shaping_time_t(-1) : times[head_x] + delay_x - now;
+            _free_count_x[i]++;
+            if (++head_x[i] == shaping_echoes) head_x[i] = 0;
+          } while (head_x[i] != tail && echo_axes[head_x[i]].x == ECHO_NONE);
+          peek_x_val[i] = head_x[i] == tail ? shaping_time_t(-1) : times[head_x[i]] + delay_x[i] - now;
           return forward;
         }
-        static bool empty_x() { return head_x == tail; }
-        static uint16_t free_count_x() { return _free_count_x; }
+        static bool empty_x() { return head_x[echoes_x - 1] == tail; }
       #endif
       #if ENABLED(INPUT_SHAPING_Y)
-        static shaping_time_t peek_y() { return peek_y_val; }
-        static bool dequeue_y() {
-          bool forward = echo_axes[head_y].y == ECHO_FWD;
+        static shaping_time_t peek_y() {
+          shaping_time_t t = peek_y_val[0];
+          for (uint8_t i = 1; i < echoes_y; ++i) NOMORE(t, peek_y_val[i]);
+          return t;
+        }
+        static int8_t ready_y(const uint16_t min_free) {
+          for (uint8_t i = 0; i < echoes_y; ++i) if (!peek_y_val[i] || _free_count_y[i] < min_free) return i;
+          return -1;
+        }
+        static bool dequeue_y(const uint8_t i) {
+          bool forward = echo_axes[head_y[i]].y == ECHO_FWD;
           do {
-            _free_count_y++;
-            if (++head_y == shaping_echoes) head_y = 0;
-          } while (head_y != tail && echo_axes[head_y].y == ECHO_NONE);
-          peek_y_val = head_y == tail ? shaping_time_t(-1) : times[head_y] + delay_y - now;
+            _free_count_y[i]++;
+            if (++head_y[i] == shaping_echoes) head_y[i] = 0;
+          } while (head_y[i] != tail && echo_axes[head_y[i]].y == ECHO_NONE);
+          peek_y_val[i] = head_y[i] == tail ? shaping_time_t(-1) : times[head_y[i]] + delay_y[i] - now;
           return forward;
         }
-        static bool empty_y() { return head_y == tail; }
-        static uint16_t free_count_y() { return _free_count_y; }
+        static bool empty_y() { return head_y[echoes_y - 1] == tail; }
       #endif
       static void purge() {
         const auto st = shaping_time_t(-1);
         #if ENABLED(INPUT_SHAPING_X)
-          head_x = tail; _free_count_x = shaping_echoes - 1; peek_x_val = st;
+          for (uint8_t i = 0; i < shaping_max_echoes; ++i) { head_x[i] = tail; _free_count_x[i] = shaping_echoes - 1; peek_x_val[i] = st; }
         #endif
         #if ENABLED(INPUT_SHAPING_Y)
-          head_y = tail; _free_count_y = shaping_echoes - 1; peek_y_val = st;
+          for (uint8_t i = 0; i < shaping_max_echoes; ++i) { head_y[i] = tail; _free_count_y[i] = shaping_echoes - 1; peek_y_val[i] = st; }
         #endif
       }
   };
@@ -462,16 +530,35 @@ constexpr ena_mask_t enable_overlap[] = {
   struct ShapeParams {
     float frequency;
     float zeta;
+    ShapingType type;
     bool enabled : 1;
     bool forward : 1;
     int16_t delta_error = 0;    // delta_error for seconday bresenham mod 128
-    uint8_t factor1;
-    uint8_t factor2;
+    uint8_t factor[SHAPING_MAX_IMPULSES]; // Impulse amplitudes in 1:7 fixed point, summing to 128
     int32_t last_block_end_pos = 0;
   };
 
 #endif // HAS_ZV_SHAPING
 
+#if ENABLED(ACCEL_RAMP_TABLE)
+
+  /**
+   * Positions on the acceleration ramp count 1/16 steps from standstill, where
+   * the step rate is sqrt(2 * accel * steps). Each octave of position has 8
+   * segments and the interval is interpolated linearly within a segment.
+   */
+  #define RAMP_UNITS_PER_STEP 16
+  #define RAMP_SEG_MIN (3 << 3)         // Octave 3 is the first with whole-unit segments
+  #define RAMP_SEG_MAX ((29 << 3) | 7)  // Positions below 2^30
+
+  #ifdef __AVR__
+    typedef uint16_t ramp_ticks_t;
+  #else
+    typedef uint32_t ramp_ticks_t;
+  #endif
+
+#endif
+
 //
 // Stepper class definition
 //
@@ -606,6 +693,15 @@ class Stepper {
       static uint32_t acc_step_rate; // needed for deceleration start point
     #endif
 
+    #if ENABLED(ACCEL_RAMP_TABLE)
+      static uint8_t ramp_seg,          // Current segment of the acceleration ramp
+                     ramp_shift;        // Multistepping of the last ramp interval (log2)
+      static uint32_t ramp_frac,        // Position within the segment, as a 24-bit fraction
+                      ramp_inc;         // Fraction covered by one step in this segment
+      static ramp_ticks_t ramp_ticks,   // Interval at the start of the segment
+                          ramp_delta;   // Interval change across the segment
+    #endif
+
     // Exact steps at which an endstop was triggered
     static xyz_long_t endstops_trigsteps;
 
@@ -693,7 +789,7 @@ class Stepper {
     // Discard current block and free any resources
     FORCE_INLINE static void discard_current_block() {
       #if ENABLED(DIRECT_STEPPING)
-        if (current_block->is_page()) page_manager.free_page(current_block->page_idx);
+        if (planner.plan_of(current_block).is_page()) page_manager.free_page(current_block->page_idx);
       #endif
       current_block = nullptr;
       axis_did_move = 0;
@@ -818,6 +914,20 @@ class Stepper {
       static float get_shaping_damping_ratio(const AxisEnum axis);
       static void set_shaping_frequency(const AxisEnum axis, const_float_t freq);
       static float get_shaping_frequency(const AxisEnum axis);
+      static void set_shaping_type(const AxisEnum axis, const ShapingType type);
+      static ShapingType get_shaping_type(const AxisEnum axis);
+      static void calc_shaping_factors(const ShapingType type, const_float_t zeta, uint8_t factor[SHAPING_MAX_IMPULSES]);
+    #endif
+
+    #if ENABLED(CALIBRATE_MULTISTEPPING)
+      static uint32_t multistep_limit[8];   // Highest ISR rate for 1x to 128x stepping, set by M881 C
+      static void set_multistep_limits(const uint32_t limits[8]);
+      static void reset_multistep_limits();
+    #endif
+
+    #if ENABLED(ACCEL_RAMP_TABLE)
+      // Find the ramp segment and fraction for a position in 1/16 steps
+      static void ramp_locate(const_float_t pos, uint8_t &seg, uint32_t &frac);
     #endif
 
   private:
@@ -829,6 +939,13 @@ class Stepper {
     static uint32_t calc_timer_interval(uint32_t step_rate);
     static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t &loops);
 
+    #if ENABLED(ACCEL_RAMP_TABLE)
+      static void ramp_load();
+      static void ramp_forward();
+      static void ramp_back();
+      static uint32_t ramp_timer_interval(uint8_t &loops);
+    #endif
+
     #if ENABLED(S_CURVE_ACCELERATION)
       static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
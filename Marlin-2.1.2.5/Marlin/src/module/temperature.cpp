@@ -194,6 +194,10 @@
   #include "../libs/buzzer.h"
 #endif
 
+#if ENABLED(THERMISTOR_DIRECT_LOOKUP)
+  #include "thermistor/thermistor_index.h"
+#endif
+
 #if HAS_SERVOS
   #include "servo.h"
 #endif
@@ -208,6 +212,13 @@
   #define NEXT_TEMPTABLE_LEN(N) ,TEMPTABLE_##N##_LEN
   static const temp_entry_t* heater_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS(TEMPTABLE_0 REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE));
   static constexpr uint8_t heater_ttbllen_map[HOTENDS] = ARRAY_BY_HOTENDS(TEMPTABLE_0_LEN REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE_LEN));
+  #if ENABLED(THERMISTOR_DIRECT_LOOKUP)
+    #define _TTBL_INDEX(N) THERMISTOR_INDEX(TEMPTABLE_##N, TEMPTABLE_##N##_LEN)
+    #define NEXT_TEMPTABLE_SEG(N) ,(_TTBL_INDEX(N).seg)
+    #define NEXT_TEMPTABLE_SLOPE(N) ,(_TTBL_INDEX(N).slope)
+    static const uint8_t* const heater_tseg_map[HOTENDS] = ARRAY_BY_HOTENDS((_TTBL_INDEX(0).seg) REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE_SEG));
+    static const int32_t* const heater_tslope_map[HOTENDS] = ARRAY_BY_HOTENDS((_TTBL_INDEX(0).slope) REPEAT_S(1, HOTENDS, NEXT_TEMPTABLE_SLOPE));
+  #endif
 #endif
 
 Temperature thermalManager;
@@ -568,6 +579,58 @@ PGMSTR(str_t_heating_failed, STR_T_HEATING_FAILED);
 
 volatile bool Temperature::raw_temps_ready = false;
 
+#if ENABLED(TEMP_SENSOR_FILTERS)
+
+  #define _DIVIDER_OK(F) (IS_POWER_OF_2(F.divider) && F.divider <= OVERSAMPLENR)
+  static_assert(_DIVIDER_OK(filter_hotend) && _DIVIDER_OK(filter_bed) && _DIVIDER_OK(filter_other),
+                "TEMP_FILTER_* divider must be a power of 2 (1, 2, 4, ...) up to " STRINGIFY(OVERSAMPLENR) ".");
+  #undef _DIVIDER_OK
+
+  #define UPDATE_SENSOR(T,F) T.update(F)
+
+  /**
+   * Filter a completed reading: hold back sudden jumps for a few readings,
+   * take the median of the last three readings, then apply a moving average.
+   */
+  void TempInfo::update(const temp_filter_t &f) {
+    raw_adc_t r = acc * f.divider; // Sampled on 1 of 'divider' rounds
+
+    if (!primed) {
+      primed = true;
+      prev[0] = prev[1] = r;
+      ema = uint32_t(r) << f.ema_shift;
+    }
+
+    // A jump that persists is a real change, so only hold back a few readings
+    if (f.outlier && ABS(int32_t(r) - int32_t(prev[0])) > f.outlier && held < 3) {
+      ++held;
+      r = prev[0];
+    }
+    else
+      held = 0;
+
+    raw_adc_t m = r;
+    if (f.median) {
+      const raw_adc_t a = prev[0], b = prev[1];
+      m = _MAX(_MIN(a, b), _MIN(_MAX(a, b), r));
+    }
+    prev[1] = prev[0];
+    prev[0] = r;
+
+    if (f.ema_shift) {
+      ema += m - (ema >> f.ema_shift);
+      m = ema >> f.ema_shift;
+    }
+
+    raw = m;
+  }
+
+#else
+
+  #define UPDATE_SENSOR(T,F) T.update()
+
+#endif
+
 #if ENABLED(MPCTEMP)
   int32_t Temperature::mpc_e_position; // = 0
 #endif
@@ -1468,6 +1531,8 @@ void Temperature::mintemp_error(const heater_id_t heater_id) {
         ambient_xfer_coeff += fan_fraction * mpc.fan255_adjustment;
       #endif
 
+      TERN_(MPC_FLOW_LOOKAHEAD, float power_xfer_coeff = ambient_xfer_coeff);
+
       if (this_hotend) {
         const int32_t e_position = stepper.position(E_AXIS);
         const float e_speed = (e_position - mpc_e_position) * planner.mm_per_step[E_AXIS] / MPC_dT;
@@ -1479,6 +1544,12 @@ void Temperature::mintemp_error(const heater_id_t heater_id) {
           ambient_xfer_coeff += e_speed * mpc.filament_heat_capacity_permm;
           mpc_e_position = e_position;
         }
+
+        #if ENABLED(MPC_FLOW_LOOKAHEAD)
+          // Plan power for the queued extrusion if it's faster, so the heater ramps up in time
+          const float ahead_e_speed = planner.e_speed_ahead(uint32_t((MPC_FLOW_LOOKAHEAD_TIME) * 1000000UL), ee);
+          power_xfer_coeff = _MAX(ambient_xfer_coeff, power_xfer_coeff + ahead_e_speed * mpc.filament_heat_capacity_permm);
+        #endif
       }
 
       // Update the modeled temperatures
@@ -1503,7 +1574,7 @@ void Temperature::mintemp_error(const heater_id_t heater_id) {
       if (hotend.target != 0 && !is_idling) {
         // Plan power level to get to target temperature in 2 seconds
         power = (hotend.target - hotend.modeled_block_temp) * mpc.block_heat_capacity / 2.0f;
-        power -= (hotend.modeled_ambient_temp - hotend.modeled_block_temp) * ambient_xfer_coeff;
+        power -= (hotend.modeled_ambient_temp - hotend.modeled_block_temp) * TERN(MPC_FLOW_LOOKAHEAD, power_xfer_coeff, ambient_xfer_coeff);
       }
 
       float pid_output = power * 254.0f / mpc.heater_power + 1.0f;        // Ensure correct quantization into a range of 0 to 127
@@ -1988,6 +2059,104 @@ void Temperature::task() {
   }                                                                       \
 }while(0)
 
+#if ENABLED(THERMISTOR_DIRECT_LOOKUP)
+
+  /**
+   * Get the segment of the 'raw' value from its index bucket, then interpolate
+   * with the segment's fixed-point slope. Same result as SCAN_THERMISTOR_TABLE.
+   */
+  static celsius_float_t lookup_thermistor_index(const temp_entry_t * const tbl, const uint8_t len, const uint8_t * const seg, const int32_t * const slope, raw_adc_t raw) {
+    NOMORE(raw, raw_adc_t(MAX_RAW_THERMISTOR_VALUE));
+    uint8_t k = pgm_read_byte(&seg[raw >> thermistor_bucket_shift]);
+    while (k < len && raw > raw_adc_t(pgm_read_word(&tbl[k].value))) ++k;
+    if (!k) return celsius_t(pgm_read_word(&tbl[0].celsius));
+    if (k == len) return celsius_t(pgm_read_word(&tbl[len - 1].celsius));
+    const raw_adc_t v0 = pgm_read_word(&tbl[k - 1].value);
+    const celsius_t c0 = celsius_t(pgm_read_word(&tbl[k - 1].celsius));
+    return celsius_float_t(int32_t(c0) * 65536 + int32_t(raw - v0) * int32_t(pgm_read_dword(&slope[k]))) * (1.0f / 65536);
+  }
+
+  #define LOOKUP_THERMISTOR_TABLE(TBL) do{ \
+    constexpr auto &tidx = THERMISTOR_INDEX(TBL, TBL##_LEN); \
+    return lookup_thermistor_index(TBL, TBL##_LEN, tidx.seg, tidx.slope, raw); \
+  }while(0)
+
+  #if ENABLED(MARLIN_DEV_MODE)
+
+    static celsius_float_t scan_thermistor_table(const temp_entry_t * const tbl, const uint8_t len, const raw_adc_t raw) {
+      SCAN_THERMISTOR_TABLE(tbl, len);
+    }
+
+    // Time both lookups over the whole raw range and compare their results
+    static void benchmark_thermistor_table(FSTR_P const label, const int8_t n, const temp_entry_t * const tbl, const uint8_t len, const uint8_t * const seg, const int32_t * const slope) {
+      if (len < 2) return;
+
+      volatile celsius_float_t sink;
+      millis_t t0 = millis();
+      for (uint32_t r = 0; r < thermistor_raw_range; ++r) sink = scan_thermistor_table(tbl, len, raw_adc_t(r));
+      const millis_t scan_ms = millis() - t0;
+      hal.watchdog_refresh();
+
+      t0 = millis();
+      for (uint32_t r = 0; r < thermistor_raw_range; ++r) sink = lookup_thermistor_index(tbl, len, seg, slope, raw_adc_t(r));
+      const millis_t direct_ms = millis() - t0;
+      hal.watchdog_refresh();
+      UNUSED(sink);
+
+      float max_diff = 0;
+      for (uint32_t r = 0; r < thermistor_raw_range; ++r)
+        NOLESS(max_diff, ABS(lookup_thermistor_index(tbl, len, seg, slope, raw_adc_t(r)) - scan_thermistor_table(tbl, len, raw_adc_t(r))));
+      hal.watchdog_refresh();
+
+      SERIAL_ECHOF(label);
+      if (n >= 0) SERIAL_ECHO(n);
+      SERIAL_ECHOLNPGM(
+        ": search ", LROUND(scan_ms * 1000000.0f / thermistor_raw_range),
+        "ns direct ", LROUND(direct_ms * 1000000.0f / thermistor_raw_range),
+        "ns max diff ", max_diff
+      );
+    }
+
+    /**
+     * D8: Compare the binary search and the direct index of each thermistor
+     * table in use, reporting the mean time per lookup and the largest difference.
+     */
+    void Temperature::benchmark_thermistor_lookup() {
+      #if HAS_HOTEND_THERMISTOR
+        HOTEND_LOOP() benchmark_thermistor_table(F("E"), e, heater_ttbl_map[e], heater_ttbllen_map[e], heater_tseg_map[e], heater_tslope_map[e]);
+      #endif
+      #define _BENCHMARK_TABLE(N) do{ \
+        constexpr auto &tidx = THERMISTOR_INDEX(TEMPTABLE_##N, TEMPTABLE_##N##_LEN); \
+        benchmark_thermistor_table(F(STRINGIFY(N)), -1, TEMPTABLE_##N, TEMPTABLE_##N##_LEN, tidx.seg, tidx.slope); \
+      }while(0)
+      #if TEMP_SENSOR_BED_IS_THERMISTOR
+        _BENCHMARK_TABLE(BED);
+      #endif
+      #if TEMP_SENSOR_CHAMBER_IS_THERMISTOR
+        _BENCHMARK_TABLE(CHAMBER);
+      #endif
+      #if TEMP_SENSOR_COOLER_IS_THERMISTOR
+        _BENCHMARK_TABLE(COOLER);
+      #endif
+      #if TEMP_SENSOR_PROBE_IS_THERMISTOR
+        _BENCHMARK_TABLE(PROBE);
+      #endif
+      #if TEMP_SENSOR_BOARD_IS_THERMISTOR
+        _BENCHMARK_TABLE(BOARD);
+      #endif
+      #if TEMP_SENSOR_REDUNDANT_IS_THERMISTOR
+        _BENCHMARK_TABLE(REDUNDANT);
+      #endif
+    }
+
+  #endif // MARLIN_DEV_MODE
+
+#else
+
+  #define LOOKUP_THERMISTOR_TABLE(TBL) SCAN_THERMISTOR_TABLE(TBL, TBL##_LEN)
+
+#endif
+
 #if HAS_USER_THERMISTORS
 
   user_thermistor_t Temperature::user_thermistor[USER_THERMISTORS]; // Initialized by settings.load
@@ -2229,8 +2398,12 @@ void Temperature::task() {
 
     #if HAS_HOTEND_THERMISTOR
       // Thermistor with conversion table?
-      const temp_entry_t(*tt)[] = (temp_entry_t(*)[])(heater_ttbl_map[e]);
-      SCAN_THERMISTOR_TABLE((*tt), heater_ttbllen_map[e]);
+      #if ENABLED(THERMISTOR_DIRECT_LOOKUP)
+        return lookup_thermistor_index(heater_ttbl_map[e], heater_ttbllen_map[e], heater_tseg_map[e], heater_tslope_map[e], raw);
+      #else
+        const temp_entry_t(*tt)[] = (temp_entry_t(*)[])(heater_ttbl_map[e]);
+        SCAN_THERMISTOR_TABLE((*tt), heater_ttbllen_map[e]);
+      #endif
     #endif
 
     return 0;
@@ -2252,7 +2425,7 @@ void Temperature::task() {
         return (int16_t)raw * 0.25f;
       #endif
     #elif TEMP_SENSOR_BED_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_BED, TEMPTABLE_BED_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_BED);
     #elif TEMP_SENSOR_BED_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_BED_IS_AD8495
@@ -2270,7 +2443,7 @@ void Temperature::task() {
     #if TEMP_SENSOR_CHAMBER_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_CHAMBER, raw);
     #elif TEMP_SENSOR_CHAMBER_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_CHAMBER, TEMPTABLE_CHAMBER_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_CHAMBER);
     #elif TEMP_SENSOR_CHAMBER_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_CHAMBER_IS_AD8495
@@ -2288,7 +2461,7 @@ void Temperature::task() {
     #if TEMP_SENSOR_COOLER_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_COOLER, raw);
     #elif TEMP_SENSOR_COOLER_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_COOLER, TEMPTABLE_COOLER_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_COOLER);
     #elif TEMP_SENSOR_COOLER_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_COOLER_IS_AD8495
@@ -2306,7 +2479,7 @@ void Temperature::task() {
     #if TEMP_SENSOR_PROBE_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_PROBE, raw);
     #elif TEMP_SENSOR_PROBE_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_PROBE, TEMPTABLE_PROBE_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_PROBE);
     #elif TEMP_SENSOR_PROBE_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_PROBE_IS_AD8495
@@ -2324,7 +2497,7 @@ void Temperature::task() {
     #if TEMP_SENSOR_BOARD_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_BOARD, raw);
     #elif TEMP_SENSOR_BOARD_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_BOARD, TEMPTABLE_BOARD_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_BOARD);
     #elif TEMP_SENSOR_BOARD_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_BOARD_IS_AD8495
@@ -2348,7 +2521,7 @@ void Temperature::task() {
     #elif TEMP_SENSOR_IS_MAX_TC(REDUNDANT) && REDUNDANT_TEMP_MATCH(SOURCE, E2)
       return TERN(TEMP_SENSOR_REDUNDANT_IS_MAX31865, max31865_2.temperature(raw), (int16_t)raw * 0.25f);
     #elif TEMP_SENSOR_REDUNDANT_IS_THERMISTOR
-      SCAN_THERMISTOR_TABLE(TEMPTABLE_REDUNDANT, TEMPTABLE_REDUNDANT_LEN);
+      LOOKUP_THERMISTOR_TABLE(TEMPTABLE_REDUNDANT);
     #elif TEMP_SENSOR_REDUNDANT_IS_AD595
       return TEMP_AD595(raw);
     #elif TEMP_SENSOR_REDUNDANT_IS_AD8495
@@ -3393,35 +3566,34 @@ void Temperature::update_raw_temperatures() {
 
   // TODO: can this be collapsed into a HOTEND_LOOP()?
   #if HAS_TEMP_ADC_0 && !TEMP_SENSOR_IS_MAX_TC(0)
-    temp_hotend[0].update();
+    UPDATE_SENSOR(temp_hotend[0], filter_hotend);
   #endif
 
   #if HAS_TEMP_ADC_1 && !TEMP_SENSOR_IS_MAX_TC(1)
-    temp_hotend[1].update();
+    UPDATE_SENSOR(temp_hotend[1], filter_hotend);
   #endif
 
   #if HAS_TEMP_ADC_2 && !TEMP_SENSOR_IS_MAX_TC(2)
-    temp_hotend[2].update();
+    UPDATE_SENSOR(temp_hotend[2], filter_hotend);
   #endif
 
   #if HAS_TEMP_ADC_REDUNDANT && !TEMP_SENSOR_IS_MAX_TC(REDUNDANT)
-    temp_redundant.update();
+    UPDATE_SENSOR(temp_redundant, filter_hotend);
   #endif
 
   #if HAS_TEMP_ADC_BED && !TEMP_SENSOR_IS_MAX_TC(BED)
-    temp_bed.update();
+    UPDATE_SENSOR(temp_bed, filter_bed);
   #endif
 
-  TERN_(HAS_TEMP_ADC_2,       temp_hotend[2].update());
-  TERN_(HAS_TEMP_ADC_3,       temp_hotend[3].update());
-  TERN_(HAS_TEMP_ADC_4,       temp_hotend[4].update());
-  TERN_(HAS_TEMP_ADC_5,       temp_hotend[5].update());
-  TERN_(HAS_TEMP_ADC_6,       temp_hotend[6].update());
-  TERN_(HAS_TEMP_ADC_7,       temp_hotend[7].update());
-  TERN_(HAS_TEMP_ADC_CHAMBER, temp_chamber.update());
-  TERN_(HAS_TEMP_ADC_PROBE,   temp_probe.update());
-  TERN_(HAS_TEMP_ADC_COOLER,  temp_cooler.update());
-  TERN_(HAS_TEMP_ADC_BOARD,   temp_board.update());
+  TERN_(HAS_TEMP_ADC_3,       UPDATE_SENSOR(temp_hotend[3], filter_hotend));
+  TERN_(HAS_TEMP_ADC_4,       UPDATE_SENSOR(temp_hotend[4], filter_hotend));
+  TERN_(HAS_TEMP_ADC_5,       UPDATE_SENSOR(temp_hotend[5], filter_hotend));
+  TERN_(HAS_TEMP_ADC_6,       UPDATE_SENSOR(temp_hotend[6], filter_hotend));
+  TERN_(HAS_TEMP_ADC_7,       UPDATE_SENSOR(temp_hotend[7], filter_hotend));
+  TERN_(HAS_TEMP_ADC_CHAMBER, UPDATE_SENSOR(temp_chamber, filter_other));
+  TERN_(HAS_TEMP_ADC_PROBE,   UPDATE_SENSOR(temp_probe, filter_other));
+  TERN_(HAS_TEMP_ADC_COOLER,  UPDATE_SENSOR(temp_cooler, filter_other));
+  TERN_(HAS_TEMP_ADC_BOARD,   UPDATE_SENSOR(temp_board, filter_other));
 
   TERN_(HAS_JOY_ADC_X, joystick.x.update());
   TERN_(HAS_JOY_ADC_Y, joystick.y.update());
@@ -3529,6 +3701,9 @@ void Temperature::isr() {
 
   static int8_t temp_count = -1;
   static ADCSensorState adc_sensor_state = StartupDelay;
+  #if ENABLED(TEMP_SENSOR_FILTERS)
+    static uint8_t adc_skipped;   // ADC states skipped in this round
+  #endif
 
   #ifndef SOFT_PWM_SCALE
     #define SOFT_PWM_SCALE 0
@@ -3863,7 +4038,11 @@ void Temperature::isr() {
     case SensorsReady: {
       // All sensors have been read. Stay in this state for a few
       // ISRs to save on calls to temp update/checking code below.
-      constexpr int8_t extra_loops = MIN_ADC_ISR_LOOPS - (int8_t)SensorsReady;
+      #if ENABLED(TEMP_SENSOR_FILTERS)
+        const int8_t extra_loops = MIN_ADC_ISR_LOOPS - (int8_t)SensorsReady + adc_skipped;
+      #else
+        constexpr int8_t extra_loops = MIN_ADC_ISR_LOOPS - (int8_t)SensorsReady;
+      #endif
       static uint8_t delay_count = 0;
       if (extra_loops > 0) {
         if (delay_count == 0) delay_count = extra_loops;  // Init this delay
@@ -3884,6 +4063,7 @@ void Temperature::isr() {
         temp_count = 0;
         readings_ready();
       }
+      TERN_(TEMP_SENSOR_FILTERS, adc_skipped = 0);
       break;
 
     #if HAS_TEMP_ADC_0
@@ -4029,6 +4209,63 @@ void Temperature::isr() {
 
   } // switch(adc_sensor_state)
 
+  #if ENABLED(TEMP_SENSOR_FILTERS)
+    // Skip the states of sensors whose divider leaves them out of this round
+    for (;;) {
+      uint8_t divider;
+      switch (next_sensor_state) {
+        default: divider = 1; break;
+        #if HAS_TEMP_ADC_0
+          case PrepareTemp_0:
+        #endif
+        #if HAS_TEMP_ADC_1
+          case PrepareTemp_1:
+        #endif
+        #if HAS_TEMP_ADC_2
+          case PrepareTemp_2:
+        #endif
+        #if HAS_TEMP_ADC_3
+          case PrepareTemp_3:
+        #endif
+        #if HAS_TEMP_ADC_4
+          case PrepareTemp_4:
+        #endif
+        #if HAS_TEMP_ADC_5
+          case PrepareTemp_5:
+        #endif
+        #if HAS_TEMP_ADC_6
+          case PrepareTemp_6:
+        #endif
+        #if HAS_TEMP_ADC_7
+          case PrepareTemp_7:
+        #endif
+        #if HAS_TEMP_ADC_REDUNDANT
+          case PrepareTemp_REDUNDANT:
+        #endif
+          divider = filter_hotend.divider; break;
+        #if HAS_TEMP_ADC_BED
+          case PrepareTemp_BED: divider = filter_bed.divider; break;
+        #endif
+        #if HAS_TEMP_ADC_CHAMBER
+          case PrepareTemp_CHAMBER:
+        #endif
+        #if HAS_TEMP_ADC_COOLER
+          case PrepareTemp_COOLER:
+        #endif
+        #if HAS_TEMP_ADC_PROBE
+          case PrepareTemp_PROBE:
+        #endif
+        #if HAS_TEMP_ADC_BOARD
+          case PrepareTemp_BOARD:
+        #endif
+          divider = filter_other.divider; break;
+      }
+      if (!(temp_count & (divider - 1))) break;
+      next_sensor_state = (ADCSensorState)(int(next_sensor_state) + 2); // Past Prepare and Measure
+      adc_skipped += 2;
+    }
+  #endif
+
   // Go to the next state
   adc_sensor_state = next_sensor_state;
 
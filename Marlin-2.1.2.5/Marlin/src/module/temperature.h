@@ -135,7 +135,38 @@ enum ADCSensorState : char {
 // get all oversampled sensor readings
 #define MIN_ADC_ISR_LOOPS 10
 
-#define ACTUAL_ADC_SAMPLES _MAX(int(MIN_ADC_ISR_LOOPS), int(SensorsReady))
+#if ENABLED(TEMP_SENSOR_FILTERS)
+  // Filter chain for one class of sensors, applied to each oversampled reading
+  typedef struct TempFilter {
+    bool median;        // Median of the last 3 readings
+    raw_adc_t outlier;  // Hold readings that jump further than this, 0 = off
+    uint8_t ema_shift;  // Moving average weight 1/2^N for each reading, 0 = off
+    uint8_t divider;    // Sample on 1 of N rounds of the ADC state machine
+    constexpr TempFilter(const bool m, const uint16_t counts, const uint8_t e, const uint8_t d)
+      : median(m), outlier(OV(counts)), ema_shift(e), divider(d) {}
+  } temp_filter_t;
+
+  constexpr temp_filter_t filter_hotend = TEMP_FILTER_HOTEND,
+                          filter_bed    = TEMP_FILTER_BED,
+                          filter_other  = TEMP_FILTER_OTHER;
+
+  // ISR loops in round r of the ADC state machine, without the states of sensors left out of it
+  constexpr uint8_t adc_round_loops(const uint8_t r) {
+    return _MAX(int(MIN_ADC_ISR_LOOPS), int(SensorsReady) - 2 * (
+        (r % filter_hotend.divider ? COUNT_ENABLED(HAS_TEMP_ADC_0, HAS_TEMP_ADC_1, HAS_TEMP_ADC_2, HAS_TEMP_ADC_3, HAS_TEMP_ADC_4, HAS_TEMP_ADC_5, HAS_TEMP_ADC_6, HAS_TEMP_ADC_7, HAS_TEMP_ADC_REDUNDANT) : 0)
+      + (r % filter_bed.divider    ? COUNT_ENABLED(HAS_TEMP_ADC_BED) : 0)
+      + (r % filter_other.divider  ? COUNT_ENABLED(HAS_TEMP_ADC_CHAMBER, HAS_TEMP_ADC_COOLER, HAS_TEMP_ADC_PROBE, HAS_TEMP_ADC_BOARD) : 0)
+    ));
+  }
+  // ISR loops for all OVERSAMPLENR rounds of one reading
+  constexpr uint16_t adc_cycle_loops(const uint8_t r=0) {
+    return r < OVERSAMPLENR ? adc_round_loops(r) + adc_cycle_loops(r + 1) : 0;
+  }
+
+  #define ACTUAL_ADC_SAMPLES (float(adc_cycle_loops()) / (OVERSAMPLENR)) // Average, as dividers shorten some rounds
+#else
+  #define ACTUAL_ADC_SAMPLES _MAX(int(MIN_ADC_ISR_LOOPS), int(SensorsReady))
+#endif
 
 //
 // PID
@@ -399,11 +430,20 @@ typedef struct TempInfo {
   private:
     raw_adc_t acc;
     raw_adc_t raw;
+    #if ENABLED(TEMP_SENSOR_FILTERS)
+      raw_adc_t prev[2];  // The last two unfiltered readings
+      uint32_t ema;       // Moving average, scaled by 2^ema_shift
+      uint8_t held;       // Readings held back as outliers in a row
+      bool primed;
+    #endif
   public:
     celsius_float_t celsius;
     inline void reset() { acc = 0; }
     inline void sample(const raw_adc_t s) { acc += s; }
     inline void update() { raw = acc; }
+    #if ENABLED(TEMP_SENSOR_FILTERS)
+      void update(const temp_filter_t &f);
+    #endif
     void setraw(const raw_adc_t r) { raw = r; }
     raw_adc_t getraw() const { return raw; }
 } temp_info_t;
@@ -843,6 +883,9 @@ class Temperature {
     #if HAS_TEMP_REDUNDANT
       static celsius_float_t analog_to_celsius_redundant(const raw_adc_t raw);
     #endif
+    #if ALL(THERMISTOR_DIRECT_LOOKUP, MARLIN_DEV_MODE)
+      static void benchmark_thermistor_lookup();
+    #endif
 
     #if HAS_FAN
 
@@ -0,0 +1,76 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Direct thermistor table index
+ *
+ * The thermistor tables are sorted by raw ADC value but unevenly spaced, so a plain
+ * lookup has to binary search for the segment and divide to interpolate. This index
+ * splits the raw range into evenly spaced buckets, each holding the first table entry
+ * at or above its start, so the segment is found from the top bits of the raw value
+ * and a step or two along the table. The slope of each segment is precomputed in
+ * 16.16 fixed point, so interpolation is a single multiply.
+ *
+ * The index is built from the PROGMEM table by the compiler and stored in flash.
+ */
+
+#include "thermistors.h"
+
+#define THERMISTOR_INDEX_BITS 7
+#define THERMISTOR_INDEX_BUCKETS _BV(THERMISTOR_INDEX_BITS)
+
+constexpr uint8_t thermistor_raw_bits(const uint32_t n) { return n > 1 ? 1 + thermistor_raw_bits(n >> 1) : 0; }
+constexpr uint32_t thermistor_raw_range = uint32_t(MAX_RAW_THERMISTOR_VALUE) + 1;
+constexpr uint8_t thermistor_bucket_shift = thermistor_raw_bits(thermistor_raw_range) - (THERMISTOR_INDEX_BITS);
+
+static_assert(!(thermistor_raw_range & (thermistor_raw_range - 1)), "THERMISTOR_DIRECT_LOOKUP requires a power-of-2 raw ADC range.");
+static_assert(thermistor_raw_range >= THERMISTOR_INDEX_BUCKETS, "THERMISTOR_DIRECT_LOOKUP requires a raw ADC range of at least 128.");
+
+template<uint8_t LEN>
+struct thermistor_index_t {
+  uint8_t seg[THERMISTOR_INDEX_BUCKETS]; // First entry with value >= the bucket start
+  int32_t slope[LEN ? LEN : 1];          // (°C per raw unit) << 16 from the previous entry
+
+  constexpr thermistor_index_t(const temp_entry_t * const tbl) : seg{}, slope{} {
+    uint8_t k = 0;
+    for (uint16_t b = 0; b < THERMISTOR_INDEX_BUCKETS; ++b) {
+      while (k < LEN && tbl[k].value < (uint32_t(b) << thermistor_bucket_shift)) ++k;
+      seg[b] = k;
+    }
+    for (uint8_t i = 1; i < LEN; ++i) {
+      const int32_t dv = int32_t(tbl[i].value) - tbl[i - 1].value;
+      const float s = dv ? float(tbl[i].celsius - tbl[i - 1].celsius) * 65536 / dv : 0;
+      slope[i] = int32_t(s < 0 ? s - 0.5f : s + 0.5f);
+    }
+  }
+};
+
+// One index per table, shared by all sensors that use it
+template<const temp_entry_t *TBL, uint8_t LEN>
+struct ThermistorIndex {
+  static constexpr thermistor_index_t<LEN> data PROGMEM = thermistor_index_t<LEN>(TBL);
+};
+template<const temp_entry_t *TBL, uint8_t LEN>
+constexpr thermistor_index_t<LEN> ThermistorIndex<TBL, LEN>::data;
+
+#define THERMISTOR_INDEX(TBL, LEN) ThermistorIndex<TBL, LEN>::data
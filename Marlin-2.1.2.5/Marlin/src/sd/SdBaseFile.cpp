@@ -1398,6 +1398,20 @@ int16_t SdBaseFile::read(void * const buf, uint16_t nbyte) {
     // amount to be read from current block
     NOMORE(n, 512 - offset);
 
+    #if ENABLED(SD_READ_AHEAD)
+      // Read whole blocks up to the end of the cluster in one go, bypassing the cache
+      uint8_t blocks = 1;
+      if (n == 512 && type_ != FAT_FILE_TYPE_ROOT_FIXED) {
+        blocks = _MIN(toRead >> 9, vol_->blocksPerCluster() - vol_->blockOfCluster(curPosition_));
+        if (vol_->cacheBlockNumber() - block < blocks) blocks = 1;
+      }
+      if (blocks > 1) {
+        if (!vol_->readBlocks(block, dst, blocks)) return -1;
+        n = 512U * blocks;
+      }
+      else
+    #endif
+
     // no buffering needed if n == 512
     if (n == 512 && block != vol_->cacheBlockNumber()) {
       if (!vol_->readBlock(block, dst)) return -1;
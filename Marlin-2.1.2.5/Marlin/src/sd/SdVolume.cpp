@@ -148,6 +148,27 @@ bool SdVolume::cacheRawBlock(const uint32_t blockNumber, const bool dirty) {
   return true;
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Read consecutive blocks with a single multi-block command where the driver
+   * supports it. Fall back to single block reads (with their retries) on error.
+   */
+  bool SdVolume::readBlocks(const uint32_t block, uint8_t * const dst, const uint8_t count) {
+    #if !(IS_TEENSY_35_36 || IS_TEENSY_40_41)   // Teensy SDHC only does single block reads
+      if (count > 1 && sdCard_->readStart(block)) {
+        uint8_t i = 0;
+        while (i < count && sdCard_->readData(dst + 512U * i)) ++i;
+        if (sdCard_->readStop() && i == count) return true;
+      }
+    #endif
+    for (uint8_t i = 0; i < count; ++i)
+      if (!sdCard_->readBlock(block + i, dst + 512U * i)) return false;
+    return true;
+  }
+
+#endif
+
 // return the size in bytes of a cluster chain
 bool SdVolume::chainSize(uint32_t cluster, uint32_t * const size) {
   uint32_t s = 0;
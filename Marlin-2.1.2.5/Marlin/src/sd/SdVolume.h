@@ -197,6 +197,9 @@ class SdVolume {
     return cluster >= FAT32EOC_MIN;
   }
   bool readBlock(const uint32_t block, uint8_t * const dst) { return sdCard_->readBlock(block, dst); }
+  #if ENABLED(SD_READ_AHEAD)
+    bool readBlocks(const uint32_t block, uint8_t * const dst, const uint8_t count);
+  #endif
   bool writeBlock(const uint32_t block, const uint8_t * const dst) { return sdCard_->writeBlock(block, dst); }
 };
 
@@ -148,6 +148,11 @@ MediaFile CardReader::file;
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if ENABLED(SD_READ_AHEAD)
+  uint8_t CardReader::ra_buffer[2 * SD_READ_AHEAD_HALF];
+  uint16_t CardReader::ra_index, CardReader::ra_count;
+#endif
+
 CardReader::CardReader() {
   changeMedia(&
     #if HAS_USB_FLASH_DRIVE && !SHARED_VOLUME_IS(SD_ONBOARD)
@@ -591,6 +596,7 @@ void CardReader::endFilePrintNow(TERN_(SD_RESORT, const bool re_sort/*=false*/))
   TERN_(DWIN_CREALITY_LCD, HMI_flag.print_finish = flag.sdprinting);
   flag.abort_sd_printing = false;
   if (isFileOpen()) file.close();
+  TERN_(SD_READ_AHEAD, ra_count = 0);
   TERN_(SD_RESORT, if (re_sort) presort());
 }
 
@@ -697,6 +703,14 @@ void CardReader::openFileRead(const char * const path, const uint8_t subcall_typ
   if (file.open(diveDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(SD_READ_AHEAD, ra_count = 0);
+
+    #if ENABLED(SD_PREPARSED_GCODE)
+      // A header line (a comment to other readers) allows pre-parsed records
+      char head[7];
+      flag.preparsed = file.read(head, sizeof(head)) == int16_t(sizeof(head)) && !strncmp_P(head, PSTR(";MGCB1\n"), sizeof(head));
+      file.seekSet(0);
+    #endif
 
     { // Don't remove this block, as the PORT_REDIRECT is a RAII
       PORT_REDIRECT(SerialMask::All);
@@ -871,6 +885,7 @@ void CardReader::closefile(const bool store_location/*=false*/) {
   file.close();
   flag.saving = flag.logging = false;
   sdpos = 0;
+  TERN_(SD_READ_AHEAD, ra_count = 0);
   TERN_(EMERGENCY_PARSER, emergency_parser.enable());
 
   if (store_location) {
@@ -1295,6 +1310,7 @@ int16_t CardReader::get_num_items() {
 //
 void CardReader::fileHasFinished() {
   file.close();
+  TERN_(SD_READ_AHEAD, ra_count = 0);
   #if HAS_MEDIA_SUBCALLS
     if (file_subcall_ctr > 0) { // Resume calling file after closing procedure
       file_subcall_ctr--;
@@ -1311,6 +1327,80 @@ void CardReader::fileHasFinished() {
   marlin_state = MF_SD_COMPLETE;  // Tell Marlin to enqueue M1001 soon
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Refill any free half of the read-ahead buffer. Reads are aligned to whole
+   * blocks so SdBaseFile can read them straight into the buffer, many at once.
+   * Called when the buffer runs dry and while the command queue is full.
+   */
+  void CardReader::readahead_fill() {
+    if (!isFileOpen()) return;
+    if (!ra_count) ra_index = file.curPosition() % SD_READ_AHEAD_HALF;
+    while (ra_count <= sizeof(ra_buffer) - SD_READ_AHEAD_HALF && file.curPosition() < filesize) {
+      const uint16_t fill = (ra_index + ra_count) % sizeof(ra_buffer);
+      const int16_t n = file.read(ra_buffer + fill, SD_READ_AHEAD_HALF - fill % SD_READ_AHEAD_HALF);
+      if (n <= 0) break;
+      ra_count += n;
+    }
+  }
+
+  // Get the run of buffered bytes up to the end of the buffer, refilling if empty
+  uint16_t CardReader::readahead(const uint8_t* &data) {
+    if (!ra_count) readahead_fill();
+    data = ra_buffer + ra_index;
+    return _MIN(ra_count, sizeof(ra_buffer) - ra_index);
+  }
+
+  int16_t CardReader::get() {
+    const uint8_t *data;
+    if (!readahead(data)) return -1;
+    const uint8_t c = *data;
+    consume(1);
+    return c;
+  }
+
+  #if ENABLED(SD_PREPARSED_GCODE)
+
+    int16_t CardReader::peek() {
+      const uint8_t *data;
+      return readahead(data) ? *data : -1;
+    }
+
+    // Copy bytes out of the read-ahead buffer, refilling as needed
+    bool CardReader::getBytes(void *buf, uint16_t nbyte) {
+      uint8_t *dst = (uint8_t*)buf;
+      while (nbyte) {
+        const uint8_t *data;
+        const uint16_t n = _MIN(readahead(data), nbyte);
+        if (!n) return false;
+        memcpy(dst, data, n);
+        consume(n);
+        dst += n;
+        nbyte -= n;
+      }
+      return true;
+    }
+
+  #endif
+
+  // Read directly from the file, leaving sdpos at the new position for get() and getIndex()
+  int16_t CardReader::read(void *buf, uint16_t nbyte) {
+    readahead_drop();
+    if (!file.isOpen()) return -1;
+    const int16_t n = file.read(buf, nbyte);
+    sdpos = file.curPosition();
+    return n;
+  }
+
+  // Discard buffered data, returning the file to the last consumed byte
+  void CardReader::readahead_drop() {
+    if (ra_count && file.isOpen()) file.seekSet(file.curPosition() - ra_count);
+    ra_count = 0;
+  }
+
+#endif // SD_READ_AHEAD
+
 #if ENABLED(AUTO_REPORT_SD_STATUS)
   AutoReporter<CardReader::AutoReportSD> CardReader::auto_reporter;
 #endif
@@ -87,6 +87,9 @@ typedef struct {
        #if ENABLED(BINARY_FILE_TRANSFER)
          , binary_mode:1        // Use the serial line buffer as BinaryStream input
        #endif
+       #if ENABLED(SD_PREPARSED_GCODE)
+         , preparsed:1          // The open file may contain pre-parsed command records
+       #endif
     ;
 } card_flags_t;
 
@@ -233,10 +236,37 @@ public:
   static bool eof()              { return getIndex() >= getFileSize(); }
 
   // File data operations
-  static int16_t get()                            { int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out; }
-  static int16_t read(void *buf, uint16_t nbyte)  { return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  #if ENABLED(SD_READ_AHEAD)
+    static int16_t get();
+    static int16_t read(void *buf, uint16_t nbyte);
+    static void setIndex(const uint32_t index)      { ra_count = 0; file.seekSet((sdpos = index)); }
+
+    // Read-ahead stream for the file being printed
+    static void readahead_fill();
+    static uint16_t readahead(const uint8_t* &data);
+    static void consume(const uint16_t n) {
+      ra_index = (ra_index + n) % sizeof(ra_buffer);
+      ra_count -= n;
+      sdpos += n;
+    }
+    #if ENABLED(SD_PREPARSED_GCODE)
+      static int16_t peek();
+      static bool getBytes(void *buf, uint16_t nbyte);
+    #endif
+  #else
+    static int16_t get()                            { int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out; }
+    static int16_t read(void *buf, uint16_t nbyte)  { return file.isOpen() ? file.read(buf, nbyte) : -1; }
+    static void setIndex(const uint32_t index)      { file.seekSet((sdpos = index)); }
+    #if ENABLED(SD_PREPARSED_GCODE)
+      static int16_t peek()                         { return file.peek(); }
+      static bool getBytes(void *buf, const uint16_t nbyte) {
+        const bool ok = file.read(buf, nbyte) == int16_t(nbyte);
+        sdpos = file.curPosition();
+        return ok;
+      }
+    #endif
+  #endif
   static int16_t write(void *buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
-  static void setIndex(const uint32_t index)      { file.seekSet((sdpos = index)); }
 
   // TODO: rename to diskIODriver()
   static DiskIODriver* diskIODriver() { return driver; }
@@ -327,7 +357,16 @@ private:
   static MediaFile file;
 
   static uint32_t filesize, // Total size of the current file, in bytes
-                  sdpos;    // Index most recently read (one behind file.getPos)
+                  sdpos;    // Index of the next byte to read (bytes consumed so far)
+
+  #if ENABLED(SD_READ_AHEAD)
+    // Two halves, each refilled with whole aligned blocks. The file position is always sdpos + ra_count.
+    #define SD_READ_AHEAD_HALF ((SD_READ_AHEAD_BLOCKS) * 512U)
+    static uint8_t ra_buffer[2 * SD_READ_AHEAD_HALF];
+    static uint16_t ra_index,   // Next byte to consume
+                    ra_count;   // Bytes ready to consume
+    static void readahead_drop();
+  #endif
 
   //
   // Procedure calls to other files
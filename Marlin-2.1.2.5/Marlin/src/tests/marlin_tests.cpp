@@ -31,17 +31,26 @@
 #include "../module/stepper.h"
 #include "../module/temperature.h"
 
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "planner_benchmark.h"
+#endif
+#if ENABLED(MERGE_COLLINEAR_MOVES)
+  #include "move_merge_test.h"
+#endif
+
 // Individual tests are localized in each module.
 // Each test produces its own report.
 
 // Startup tests are run at the end of setup()
 void runStartupTests() {
   // Call post-setup tests here to validate behaviors.
+  TERN_(PLANNER_BENCHMARK, planner_benchmark());
 }
 
 // Periodic tests are run from within loop()
 void runPeriodicTests() {
   // Call periodic tests here to validate behaviors.
+  TERN_(MERGE_COLLINEAR_MOVES, move_merge_test());
 }
 
 #endif // MARLIN_TEST_BUILD
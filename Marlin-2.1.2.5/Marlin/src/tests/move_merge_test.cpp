@@ -0,0 +1,72 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * move_merge_test.cpp - Check MERGE_COLLINEAR_MOVES end to end
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ALL(MARLIN_TEST_BUILD, MERGE_COLLINEAR_MOVES)
+
+#include "move_merge_test.h"
+#include "../gcode/queue.h"
+#include "../feature/move_merge.h"
+#include "../module/planner.h"
+
+#define MERGE_TEST_MOVES 12 // Fewer than BLOCK_BUFFER_SIZE, so the block count can't wrap
+
+/**
+ * Called from loop() until done. The queue is topped up on every call, as
+ * from a host sending ahead, and loop() runs the moves. The first move goes
+ * out alone since the planner is empty, then up to MERGE_MOVES_MAX_COUNT
+ * moves are joined into each block. More blocks than that is a failure.
+ */
+void move_merge_test() {
+  static uint8_t sent;     // Commands queued so far: G91, the moves, then G90
+  static block_index_t head;
+  static bool done;        // = false
+  if (done) return;
+
+  if (!sent) head = planner.block_buffer_head;
+  for (;;) {
+    FSTR_P const cmd = !sent ? F("G91")
+                     : sent <= MERGE_TEST_MOVES ? F("G1 X0.1 Y0.05 F1200")
+                     : sent == MERGE_TEST_MOVES + 1 ? F("G90")
+                     : nullptr;
+    if (!cmd || !queue.enqueue_one(cmd)) break;
+    sent++;
+  }
+
+  // Wait until the last move has gone to the planner
+  if (sent <= MERGE_TEST_MOVES + 1 || queue.has_commands_queued() || move_merge.pending()) return;
+  done = true;
+
+  constexpr uint8_t expected = 1 + ((MERGE_TEST_MOVES) - 1 + (MERGE_MOVES_MAX_COUNT) - 1) / (MERGE_MOVES_MAX_COUNT);
+  const uint8_t blocks = block_dec_mod(planner.block_buffer_head, head);
+  if (blocks <= expected)
+    SERIAL_ECHOLNPGM("Move merge test: ", MERGE_TEST_MOVES, " moves in ", blocks, " blocks, PASS");
+  else
+    SERIAL_ERROR_MSG("Move merge test: ", MERGE_TEST_MOVES, " moves in ", blocks, " blocks, expected ", expected, ", FAIL");
+}
+
+#endif // MARLIN_TEST_BUILD && MERGE_COLLINEAR_MOVES
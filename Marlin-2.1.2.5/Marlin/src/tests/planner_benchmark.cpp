@@ -0,0 +1,239 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * planner_benchmark.cpp - Planner throughput benchmark
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+#include "planner_benchmark.h"
+#include "../MarlinCore.h"
+#include "../gcode/gcode.h"
+#include "../module/motion.h"
+#include "../module/planner.h"
+#include "../module/temperature.h"
+
+#ifdef PLANNER_BENCHMARK_FILE
+  #include <stdio.h>
+#endif
+
+#if defined(__PLAT_LINUX__) || defined(__PLAT_NATIVE_SIM__)
+  #include <chrono>
+  static uint64_t bench_nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+#else
+  static uint64_t bench_nanos() { return uint64_t(micros()) * 1000UL; }
+#endif
+
+/**
+ * Log-linear latency histogram, 4 buckets per power of 2 (~19% resolution)
+ * so percentiles can be taken without keeping every sample.
+ */
+class LatencyHistogram {
+  static constexpr uint8_t BUCKETS = 128;
+  uint32_t counts[BUCKETS], samples;
+  uint64_t total;
+
+  static uint8_t index(const uint32_t ns) {
+    if (ns < 8) return ns;
+    const uint8_t octave = 31 - __builtin_clz(ns);
+    const uint8_t i = 8 + (octave - 3) * 4 + ((ns >> (octave - 2)) & 3);
+    return _MIN(i, BUCKETS - 1);
+  }
+
+  static uint32_t lower_bound(const uint8_t i) {
+    if (i < 8) return i;
+    return uint32_t(4 + (i - 8) % 4) << ((i - 8) / 4 + 1);
+  }
+
+public:
+  uint32_t max;
+
+  void reset() { ZERO(counts); samples = max = 0; total = 0; }
+
+  void add(const uint32_t ns) {
+    counts[index(ns)]++;
+    samples++;
+    total += ns;
+    NOLESS(max, ns);
+  }
+
+  uint32_t count() const { return samples; }
+  uint64_t sum() const { return total; }
+
+  // Lower bound of the bucket holding the given percentile
+  uint32_t percentile(const uint8_t pct) const {
+    const uint32_t rank = (uint64_t(samples) * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < BUCKETS; ++i)
+      if ((seen += counts[i]) >= rank && seen) return lower_bound(i);
+    return max;
+  }
+};
+
+static LatencyHistogram latency;
+static uint32_t starved;
+
+/**
+ * Queue one move and time the planner alone. Waiting for a free block is
+ * not counted, and an empty queue after the first move means the stepper
+ * ran dry before the planner could keep up.
+ */
+static void bench_move(const xyze_pos_t &target, const_feedRate_t fr_mm_s) {
+  while (planner.is_full()) idle();
+  if (latency.count() && !planner.has_blocks_queued()) starved++;
+  const uint64_t start = bench_nanos();
+  planner.buffer_line(target, fr_mm_s);
+  latency.add(bench_nanos() - start);
+  current_position = target;
+}
+
+static void bench_begin() {
+  planner.synchronize();
+  latency.reset();
+  starved = 0;
+}
+
+static void bench_report(FSTR_P const name) {
+  planner.synchronize();
+  const uint32_t moves = latency.count(),
+                 rate = latency.sum() ? uint32_t(uint64_t(moves) * 1000000000ULL / latency.sum()) : 0;
+  SERIAL_ECHOPGM("  ");
+  SERIAL_ECHOF(name);
+  SERIAL_ECHOLNPGM(": ", moves, " moves, ", rate, " blocks/s, latency ns p50:", latency.percentile(50),
+    " p90:", latency.percentile(90), " p99:", latency.percentile(99), " max:", latency.max, ", starved:", starved);
+}
+
+// Small circles in short chords, as sliced from fine curved detail
+static void bench_dense_arcs() {
+  constexpr float radius = 2.0f, chord = 0.1f;
+  constexpr uint16_t circles = 8, segments = uint16_t(2 * M_PI * radius / chord);
+  const xy_pos_t center = { X_CENTER, Y_CENTER };
+  xyze_pos_t pos = current_position;
+  bench_begin();
+  for (uint16_t i = 1; i <= circles * segments; ++i) {
+    const float a = 2 * M_PI * i / segments;
+    pos.x = center.x + radius * cos(a);
+    pos.y = center.y + radius * sin(a);
+    pos.e += chord * 0.033f;
+    bench_move(pos, 60);
+  }
+  bench_report(F("dense arcs"));
+}
+
+// Gently curving line of very short segments
+static void bench_tiny_segments() {
+  constexpr float step = 0.1f;
+  constexpr uint16_t segments = 2000;
+  xyze_pos_t pos = current_position;
+  const float x0 = X_CENTER - segments * step / 2, y0 = Y_CENTER;
+  bench_begin();
+  for (uint16_t i = 0; i < segments; ++i) {
+    pos.x = x0 + i * step;
+    pos.y = y0 + 2.0f * sin(i * 0.05f);
+    pos.e += step * 0.033f;
+    bench_move(pos, 100);
+  }
+  bench_report(F("tiny segments"));
+}
+
+// Spiral with Z rising continuously, as in spiralized (vase mode) prints
+static void bench_vase_mode() {
+  constexpr float radius = 30.0f, chord = 0.5f, layer = 0.2f;
+  constexpr uint16_t turns = 3, segments = uint16_t(2 * M_PI * radius / chord);
+  const float z0 = current_position.z;
+  xyze_pos_t pos = current_position;
+  bench_begin();
+  for (uint16_t i = 1; i <= turns * segments; ++i) {
+    const float a = 2 * M_PI * i / segments;
+    pos.x = X_CENTER + radius * cos(a);
+    pos.y = Y_CENTER + radius * sin(a);
+    pos.z = z0 + layer * i / segments;
+    pos.e += chord * 0.033f;
+    bench_move(pos, 60);
+  }
+  bench_report(F("vase mode"));
+}
+
+#ifdef PLANNER_BENCHMARK_FILE
+
+  // Replay the G0/G1 moves of a sliced file. Modal commands that change how
+  // the moves are read are executed, everything else is skipped.
+  static void bench_file() {
+    FILE *f = fopen(PLANNER_BENCHMARK_FILE, "r");
+    if (!f) { SERIAL_ECHOLNPGM("  " PLANNER_BENCHMARK_FILE ": not found"); return; }
+    char line[MAX_CMD_SIZE];
+    bench_begin();
+    while (fgets(line, sizeof(line), f)) {
+      char * const comment = strpbrk(line, ";\r\n");
+      if (comment) *comment = '\0';
+      if (!*line) continue;
+      parser.parse(line);
+      switch (parser.command_letter) {
+        case 'G':
+          switch (parser.codenum) {
+            case 0: case 1:
+              gcode.get_destination_from_command();
+              bench_move(destination, feedrate_mm_s);
+              break;
+            case 90: case 91: case 92: gcode.process_parsed_command(true); break;
+          }
+          break;
+        case 'M':
+          if (parser.codenum == 82 || parser.codenum == 83) gcode.process_parsed_command(true);
+          break;
+      }
+    }
+    fclose(f);
+    bench_report(F(PLANNER_BENCHMARK_FILE));
+  }
+
+#endif
+
+void planner_benchmark() {
+  SERIAL_ECHOLNPGM("Planner benchmark, BLOCK_BUFFER_SIZE ", BLOCK_BUFFER_SIZE);
+
+  #if ENABLED(PREVENT_COLD_EXTRUSION)
+    const bool cold_extrude = thermalManager.allow_cold_extrude;
+    thermalManager.allow_cold_extrude = true;
+  #endif
+
+  const xyze_pos_t start = current_position;
+  bench_dense_arcs();
+  bench_tiny_segments();
+  bench_vase_mode();
+  #ifdef PLANNER_BENCHMARK_FILE
+    bench_file();
+  #endif
+
+  // Return to where the benchmark began
+  bench_move(start, 100);
+  planner.synchronize();
+
+  TERN_(PREVENT_COLD_EXTRUSION, thermalManager.allow_cold_extrude = cold_extrude);
+}
+
+#endif // PLANNER_BENCHMARK
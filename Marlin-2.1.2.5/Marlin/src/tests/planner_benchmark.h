@@ -0,0 +1,36 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2024 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * planner_benchmark.h - Planner throughput benchmark
+ *
+ * Feeds synthetic workloads (dense arcs, tiny segments, vase mode spiral)
+ * and optionally the G0/G1 moves of a sliced G-code file through
+ * Planner::buffer_line and reports for each one:
+ *
+ *  - Blocks planned per second of planner time
+ *  - Per-block planning latency percentiles (includes recalculate())
+ *  - Starvation events, where the stepper ran out of blocks mid-workload
+ */
+
+void planner_benchmark();
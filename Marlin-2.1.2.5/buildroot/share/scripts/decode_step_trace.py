@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""
+Decode a binary step trace written by the LINUX HAL (STEP_TRACE in HAL/LINUX/main.cpp)
+
+Reconstructs per-axis position, velocity and acceleration from the step
+timestamps and writes them as CSV, one row per step:
+
+  time_s, axis, position, velocity, acceleration
+
+Position is in steps, or in mm if steps/mm are given. Velocity comes from
+the interval between consecutive steps on the same axis, acceleration from
+the change in velocity between consecutive steps.
+
+Usage: decode_step_trace.py step_trace.bin [-o out.csv] [--steps-per-mm 80,80,400,93]
+"""
+
+import argparse, struct, sys
+
+def read_varints(data, pos):
+    value = shift = 0
+    for b in data[pos:]:
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if b & 0x80:
+            shift += 7
+        else:
+            yield value, pos
+            value = shift = 0
+
+def decode(data):
+    if data[:4] != b'MSTR':
+        raise ValueError("Not a step trace file")
+    version, axes = struct.unpack_from('BB', data, 4)
+    if version != 1:
+        raise ValueError("Unsupported step trace version %d" % version)
+    names = data[6:6 + axes].decode('ascii')
+    events = []
+    t = 0
+    for value, _ in read_varints(data, 6 + axes):
+        zigzag = value >> 4
+        t += (zigzag >> 1) ^ -(zigzag & 1)
+        events.append((t, (value >> 1) & 0x7, value & 1))
+    return names, events
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('trace', help='step trace file')
+    parser.add_argument('-o', '--output', help='CSV output file (default: stdout)')
+    parser.add_argument('--steps-per-mm', help='comma separated steps/mm per axis, to report in mm')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        names, events = decode(f.read())
+
+    scale = [1.0] * len(names)
+    if args.steps_per_mm:
+        for i, spm in enumerate(args.steps_per_mm.split(',')[:len(names)]):
+            scale[i] = 1.0 / float(spm)
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    out.write("time_s,axis,position,velocity,acceleration\n")
+
+    position = [0] * len(names)
+    last_t = [None] * len(names)
+    last_v = [0.0] * len(names)
+    for t_ns, axis, direction in events:
+        step = 1 if direction else -1
+        position[axis] += step
+        v = a = 0.0
+        if last_t[axis] is not None and t_ns > last_t[axis]:
+            dt = (t_ns - last_t[axis]) * 1e-9
+            v = step * scale[axis] / dt
+            a = (v - last_v[axis]) / dt
+        last_t[axis], last_v[axis] = t_ns, v
+        out.write("%.9f,%s,%g,%g,%g\n" % (t_ns * 1e-9, names[axis], position[axis] * scale[axis], v, a))
+
+    if out is not sys.stdout: out.close()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+Convert G-code into a pre-parsed file for SD_PREPARSED_GCODE
+
+Each plain G, M, or T command with numeric parameters becomes a binary record
+holding its code and fixed-point parameter values, so the firmware can skip
+the G-code parser and strtof while printing. Everything else stays as a text
+line and is handled as usual. The format is described in parser.cpp
+(GCodeParser::parse_preparsed).
+
+Usage: gcode_preparse.py input.gcode [-o output.gcb] [--max-cmd-size 96] [--keep-comments]
+       gcode_preparse.py -d input.gcb       (print a converted file as G-code)
+"""
+
+import argparse, re, struct, sys
+from decimal import Decimal
+
+HEADER = b';MGCB1\n'
+
+# Commands that read text (string_arg, value_string) or are checked by the
+# command queue before parsing. These are always left as text.
+TEXT_ONLY = { ('G', 53) } | { ('M', n) for n in (0, 1, 16, 23, 25, 28, 29, 30, 32, 33, 75, 117, 118, 552, 553, 554, 808, 928) } \
+          | { ('M', n) for n in range(810, 820) }
+
+COMMAND = re.compile(r' *([GMT])(\d+)(?:\.(\d+))? *')
+PARAM = re.compile(r'([A-Z]) *([-+]?(?:\d+\.?\d*|\.\d+))? *')
+
+# Value kinds: (tag kind, struct format, scale)
+INT8, INT16, INT32, MILLI16, MILLI32, MICRO32, FLOAT = range(1, 8)
+FORMATS = { INT8: '<b', INT16: '<h', INT32: '<i', MILLI16: '<h', MILLI32: '<i', MICRO32: '<i', FLOAT: '<f' }
+SCALES = { MILLI16: 1000, MILLI32: 1000, MICRO32: 100000 }
+
+def encode_value(text):
+    """Pick the smallest kind that gives exactly the float strtof would"""
+    d = Decimal(text)
+    decimals = len(text.split('.')[1]) if '.' in text else 0
+    if decimals == 0 or d == d.to_integral_value():
+        i = int(d)
+        if -0x80 <= i < 0x80: return INT8, i
+        if -0x8000 <= i < 0x8000: return INT16, i
+        if -0x80000000 <= i < 0x80000000: return INT32, i
+        return None
+    # Scaled integers below 2^24 convert to float exactly, so the division is correctly rounded
+    for kind in (MILLI16, MILLI32, MICRO32):
+        raw = d * SCALES[kind]
+        if raw == raw.to_integral_value() and abs(raw) < 1 << 24:
+            raw = int(raw)
+            if kind != MILLI16 or -0x8000 <= raw < 0x8000: return kind, raw
+    return FLOAT, float(d)
+
+def encode_line(line, max_size):
+    """Return a binary record for the line, or None to keep it as text"""
+    if '(' in line or '"' in line or '*' in line: return None
+    m = COMMAND.match(line)
+    if not m: return None
+    letter, code, sub = m.group(1), int(m.group(2)), m.group(3)
+    if (letter, code) in TEXT_ONLY or code > 0x7FFF or (sub and int(sub) > 255): return None
+    out = bytearray(struct.pack('<H', code | (0x8000 if sub else 0)))
+    if sub: out.append(int(sub))
+    pos = m.end()
+    while pos < len(line):
+        p = PARAM.match(line, pos)
+        if not p: return None
+        if p.end() < len(line) and not p.group(0).endswith(' ') and not line[p.end()].isupper(): return None
+        ind = ord(p.group(1)) - ord('A')
+        if p.group(2) is None:
+            out.append(ind)
+        else:
+            enc = encode_value(p.group(2))
+            if not enc: return None
+            kind, value = enc
+            out.append(kind << 5 | ind)
+            out += struct.pack(FORMATS[kind], value)
+        pos = p.end()
+    if len(out) > min(max_size - 2, 255): return None
+    return bytes([ord(letter) | 0x80, len(out)]) + out
+
+def convert(src, max_size, keep_comments):
+    out, stats = bytearray(HEADER), [0, 0]
+    for raw in src.splitlines():
+        line = raw.decode('latin-1')
+        # Leave the firmware to find comments where quotes, escapes, or parentheses may hide them
+        code = line.rstrip() if any(c in line for c in '"\\(') else line.split(';', 1)[0].rstrip()
+        if not code.strip():
+            if keep_comments and line.strip(): out += raw.rstrip() + b'\n'
+            continue
+        stats[0] += 1
+        rec = encode_line(code, max_size)
+        if rec:
+            stats[1] += 1
+            out += rec
+        else:
+            if len(code) > max_size - 1: print("Warning: line too long: " + code, file=sys.stderr)
+            if ord(code[0]) & 0x80: code = ' ' + code   # Don't look like a record
+            out += code.encode('latin-1') + b'\n'
+    return out, stats
+
+def decode(data):
+    """Yield each command as text"""
+    if not data.startswith(HEADER): raise ValueError("Not a pre-parsed file")
+    pos = len(HEADER)
+    while pos < len(data):
+        if data[pos] & 0x80:
+            letter, n = chr(data[pos] & 0x7F), data[pos + 1]
+            rec, pos = data[pos + 2:pos + 2 + n], pos + 2 + n
+            code = struct.unpack_from('<H', rec)[0]
+            text, i = letter + str(code & 0x7FFF), 2
+            if code & 0x8000: text, i = text + '.%d' % rec[2], 3
+            while i < len(rec):
+                kind, ind = rec[i] >> 5, rec[i] & 0x1F
+                text += ' ' + chr(ord('A') + ind)
+                if kind:
+                    (v,) = struct.unpack_from(FORMATS[kind], rec, i + 1)
+                    text += '%.9g' % v if kind == FLOAT else str(Decimal(v) / SCALES.get(kind, 1))
+                    i += struct.calcsize(FORMATS[kind])
+                i += 1
+            yield text
+        else:
+            end = data.find(b'\n', pos)
+            if end < 0: end = len(data)
+            yield data[pos:end].decode('latin-1')
+            pos = end + 1
+
+def main():
+    ap = argparse.ArgumentParser(description="Convert G-code for SD_PREPARSED_GCODE")
+    ap.add_argument('input')
+    ap.add_argument('-o', '--output', help="output file (default: input with .gcb extension)")
+    ap.add_argument('-d', '--decode', action='store_true', help="print a converted file as G-code")
+    ap.add_argument('--max-cmd-size', type=int, default=96, help="MAX_CMD_SIZE of the firmware (default 96)")
+    ap.add_argument('--keep-comments', action='store_true', help="keep comment lines (e.g., for thumbnails)")
+    args = ap.parse_args()
+
+    data = open(args.input, 'rb').read()
+    if args.decode:
+        for line in decode(data): print(line)
+        return
+
+    out, (lines, records) = convert(data, args.max_cmd_size, args.keep_comments)
+    path = args.output or re.sub(r'\.[^./\\]*$', '', args.input) + '.gcb'
+    open(path, 'wb').write(out)
+    print("%s: %d commands, %d pre-parsed, %d -> %d bytes" % (path, lines, records, len(data), len(out)))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+Run PID or MPC autotune against the LINUX HAL heater plant and score the result
+
+Needs a native build with VIRTUAL_TIME (see Configuration_adv.h), so a whole
+autotune and step response runs in seconds and gives the same numbers on
+every run. The plant is set with MARLIN_SIM_HOTEND / MARLIN_SIM_BED (see
+HAL/LINUX/hardware/Heater.h) or with --plant.
+
+Steps:
+  1. Autotune: M303 for PID, M306 T for MPC. Timed with the print job timer.
+  2. Cool down, then step to the target and log the temperature every second.
+  3. Report autotune time, rise time, overshoot, settle time and steady-state
+     RMS error as JSON, plus the MPC model error against the plant.
+
+With --baseline the results are compared with an earlier run and the script
+exits with status 1 if any of them got worse by more than the tolerance.
+
+Usage: heater_tune_test.py .pio/build/linux_native/debug/program [--mode mpc] [--target 200]
+                           [--plant "power=50,noise=2"] [--baseline tune.json] [--save tune.json]
+"""
+
+import argparse, json, os, re, subprocess, sys
+
+# Defaults of HeaterModel::hotend, for checking the MPC model
+PLANT = { 'power': 40.0, 'capacity': 16.7, 'xfer': 0.068, 'xfer_fan': 0.097, 'responsiveness': 0.22 }
+
+# Allowed regression per metric, absolute
+TOLERANCE = { 'tune_s': 30, 'rise_s': 3, 'overshoot': 0.5, 'settle_s': 5, 'rms': 0.1 }
+
+class Sim:
+    def __init__(self, exe, env):
+        # Unbuffered, since the simulator writes its serial output with stdio
+        self.p = subprocess.Popen(['stdbuf', '-o0', exe], stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True, bufsize=1, env=env)
+
+    def send(self, *lines):
+        """
+        Send commands in one write, so the next is already queued when one
+        finishes, and return the lines printed up to the last 'ok'
+        """
+        self.p.stdin.write(''.join(l + '\n' for l in lines))
+        self.p.stdin.flush()
+        out, oks = [], 0
+        for l in self.p.stdout:
+            if not l.startswith('echo:busy'): out.append(l.rstrip())
+            if l.startswith('ok'):
+                oks += 1
+                if oks == len(lines): return out
+        raise RuntimeError('Simulator exited during ' + lines[-1])
+
+    def reports(self, heater):
+        """
+        Yield (temperature, target) from each M155 report. Virtual time keeps
+        running while the firmware waits for the host, so timing comes from
+        the reports and not from the host.
+        """
+        for l in self.p.stdout:
+            m = re.search(r'(?:^|\s)%s:(-?[\d.]+) /(-?[\d.]+)' % heater, l)
+            if m: yield float(m.group(1)), float(m.group(2))
+        raise RuntimeError('Simulator exited')
+
+    def close(self):
+        self.p.kill()
+
+def seconds(text):
+    units = { 'y': 31536000, 'd': 86400, 'h': 3600, 'm': 60, 's': 1 }
+    return sum(int(n) * units[u] for n, u in re.findall(r'(\d+)([ydhms])', text))
+
+def autotune(sim, args):
+    if args.mode == 'pid':
+        tune = 'M303 %s S%d C8 U1' % ('E-1' if args.bed else 'E0', args.target)
+    else:
+        tune = 'M306 T'
+    out = sim.send('M75', tune, 'M77', 'M31')
+    res = { 'tune_s': seconds(next(l for l in out if 'Print time' in l)) }
+    for l in out:
+        m = re.search(r'DEFAULT_(?:bed)?K([pid]) (-?[\d.]+)', l)
+        if m: res['K' + m.group(1)] = float(m.group(2))
+        m = re.match(r'(MPC_\w+) (-?[\d.]+)', l)
+        if m: res[m.group(1)] = float(m.group(2))
+    if len(res) == 1:
+        raise RuntimeError('Autotune failed:\n' + '\n'.join(out[-5:]))
+    return res
+
+def step_response(sim, args):
+    heater, cmd = ('B', 'M140') if args.bed else ('T', 'M104')
+    sim.send('M155 S1', cmd + ' S0')
+    for t, _ in sim.reports(heater):
+        if t <= args.start: break
+    sim.send('%s S%d' % (cmd, args.target))
+    log = []
+    for t, target in sim.reports(heater):
+        if target == args.target: log.append(t)
+        if len(log) == args.duration: break
+    sim.send('M155 S0', cmd + ' S0')
+    return log
+
+def score(log, target, start):
+    rise = next((i + 1 for i, t in enumerate(log) if t >= start + 0.95 * (target - start)), len(log))
+    settle = max((i + 1 for i, t in enumerate(log) if abs(t - target) > 1.0), default=0)
+    tail = log[-60:]
+    return {
+        'rise_s': rise,
+        'overshoot': round(max(0.0, max(log) - target), 2),
+        'settle_s': settle,
+        'rms': round((sum((t - target) ** 2 for t in tail) / len(tail)) ** 0.5, 3)
+    }
+
+def model_error(res, plant):
+    """Relative error of the MPC model found by M306 against the plant"""
+    pairs = { 'MPC_BLOCK_HEAT_CAPACITY': 'capacity', 'MPC_SENSOR_RESPONSIVENESS': 'responsiveness',
+              'MPC_AMBIENT_XFER_COEFF': 'xfer', 'MPC_AMBIENT_XFER_COEFF_FAN255': 'xfer_fan' }
+    return { k + '_err': round(abs(res[k] / plant[p] - 1.0), 3) for k, p in pairs.items() if k in res }
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('exe', help='native Marlin build with VIRTUAL_TIME')
+    parser.add_argument('--mode', choices=('pid', 'mpc'), default='pid', help='autotune method (match the build)')
+    parser.add_argument('--bed', action='store_true', help='tune the bed instead of the hotend (PID only)')
+    parser.add_argument('--target', type=int, default=200, help='target temperature')
+    parser.add_argument('--start', type=float, default=40, help='cool down to this before the step')
+    parser.add_argument('--duration', type=int, default=300, help='seconds of step response to log')
+    parser.add_argument('--plant', help='heater model overrides, as in MARLIN_SIM_HOTEND')
+    parser.add_argument('--baseline', help='JSON results of an earlier run to compare with')
+    parser.add_argument('--save', help='write the results here as JSON')
+    parser.add_argument('--log', help='write the step response here as CSV')
+    args = parser.parse_args()
+
+    env = dict(os.environ)
+    var = 'MARLIN_SIM_BED' if args.bed else 'MARLIN_SIM_HOTEND'
+    if args.plant: env[var] = args.plant
+
+    plant = dict(PLANT)
+    for kv in filter(None, env.get('MARLIN_SIM_HOTEND', '').split(',')):
+        k, v = kv.split('=')
+        if k in plant: plant[k] = float(v)
+
+    sim = Sim(args.exe, env)
+    try:
+        res = autotune(sim, args)
+        log = step_response(sim, args)
+    finally:
+        sim.close()
+
+    res.update(score(log, args.target, args.start))
+    if args.mode == 'mpc' and not args.bed: res.update(model_error(res, plant))
+    print(json.dumps(res, indent=2))
+
+    if args.log:
+        with open(args.log, 'w') as f:
+            f.write('time_s,celsius\n')
+            for i, t in enumerate(log): f.write('%d,%.2f\n' % (i + 1, t))
+    if args.save:
+        with open(args.save, 'w') as f: json.dump(res, f, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f: base = json.load(f)
+        worse = [ '%s: %s -> %s' % (k, base[k], res[k]) for k, tol in TOLERANCE.items()
+                  if k in base and k in res and res[k] > base[k] + tol ]
+        worse += [ '%s: %s -> %s' % (k, base[k], res[k]) for k in res
+                   if k.endswith('_err') and k in base and res[k] > base[k] + 0.05 ]
+        if worse:
+            print('Regressed against %s:\n  %s' % (args.baseline, '\n  '.join(worse)), file=sys.stderr)
+            sys.exit(1)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+"""
+Check that a command keeps its parameters after running subcommands
+
+G29 N runs G28 with process_subcommands_now() and only then reads its other
+parameters, so it fails if the parser state isn't restored afterwards. With
+GCODE_PARSE_ON_ENQUEUE the restored command is a pre-parsed record and must
+not be parsed again as text.
+
+Needs a native build with AUTO_BED_LEVELING_BILINEAR. After M502 clears the
+mesh, "G29 N W" must home and then refuse to edit the missing grid.
+
+Usage: subcommand_test.py .pio/build/linux_native/debug/program
+"""
+
+import argparse, subprocess, sys
+
+def run(exe, lines):
+    """Send the commands and return the output up to the last 'ok'"""
+    p = subprocess.Popen(['stdbuf', '-o0', exe], stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True, bufsize=1)
+    try:
+        p.stdin.write(''.join(l + '\n' for l in lines))
+        p.stdin.flush()
+        out, oks = [], 0
+        for l in p.stdout:
+            if not l.startswith('echo:busy'): out.append(l.rstrip())
+            if l.startswith('ok'):
+                oks += 1
+                if oks == len(lines): return out
+        raise RuntimeError('Simulator exited during ' + lines[-1])
+    finally:
+        p.kill()
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('exe', help='native Marlin build with AUTO_BED_LEVELING_BILINEAR')
+    args = parser.parse_args()
+
+    out = run(args.exe, [ 'M502', 'G29 N W' ])
+    if not any('No bilinear grid' in l for l in out):
+        print('G29 N lost its parameters after G28:\n  ' + '\n  '.join(out[-10:]), file=sys.stderr)
+        sys.exit(1)
+    print('G29 N kept its parameters')
+
+if __name__ == '__main__':
+    main()